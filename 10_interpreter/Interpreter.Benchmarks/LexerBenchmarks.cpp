@@ -0,0 +1,28 @@
+#include "benchmark/benchmark.h"
+
+#include "Interpreter/Lexer.h"
+#include "ScriptGenerator.h"
+
+static void BM_LexerFlat(benchmark::State &state) {
+    Grammar grammar;
+    auto script = generate_flat_script(static_cast<size_t>(state.range(0)));
+    for (auto _: state) {
+        auto lexemes = Lexer::parse_code(script, grammar);
+        benchmark::DoNotOptimize(lexemes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * script.size()));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_LexerFlat)->RangeMultiplier(4)->Range(16, 16 << 10)->Complexity();
+
+static void BM_LexerNested(benchmark::State &state) {
+    Grammar grammar;
+    auto script = generate_nested_script(static_cast<size_t>(state.range(0)));
+    for (auto _: state) {
+        auto lexemes = Lexer::parse_code(script, grammar);
+        benchmark::DoNotOptimize(lexemes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * script.size()));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_LexerNested)->RangeMultiplier(4)->Range(4, 4 << 10)->Complexity();
@@ -0,0 +1,79 @@
+#ifndef MADEALGORITHMSHOMEWORK2_SCRIPTGENERATOR_H
+#define MADEALGORITHMSHOMEWORK2_SCRIPTGENERATOR_H
+
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+/**
+ * @brief Сгенерировать скрипт из последовательных операторов присваивания.
+ * @details Операторы не читают переменных, потому что Syntaxer::execute берёт их значения ещё при лексическом анализе.
+ * @param statements Количество операторов.
+ * @return Текст скрипта.
+ */
+inline std::string generate_flat_script(size_t statements) {
+    std::string script;
+    for (size_t i = 0; i < statements; ++i) {
+        script += "v" + std::to_string(i) + " = 2 * 3 + (7 - 1) / 2;\n";
+    }
+    return script;
+}
+
+/**
+ * @brief Сгенерировать оператор с выражением заданной глубины вложенности скобок.
+ * @details Выражение вида 1 + (1 + (1 + ...)): каждая скобка откладывает свёртку, поэтому стек анализатора растёт с глубиной.
+ * @param depth Глубина вложенности.
+ * @return Текст скрипта.
+ */
+inline std::string generate_nested_script(size_t depth) {
+    std::string script = "a = ";
+    for (size_t i = 0; i < depth; ++i) {
+        script += "1 + (";
+    }
+    script += "1";
+    script += std::string(depth, ')');
+    script += ";\n";
+    return script;
+}
+
+/**
+ * @brief Сгенерировать оператор, присваивающий переменной массив заданной длины.
+ * @param length Количество элементов массива.
+ * @return Текст скрипта.
+ */
+inline std::string generate_array_script(size_t length) {
+    std::string script = "m = [0";
+    for (size_t i = 1; i < length; ++i) {
+        script += ", " + std::to_string(i);
+    }
+    script += "];\n";
+    return script;
+}
+
+/**
+ * @brief Пока объект существует, всё, что печатается в std::cout, отбрасывается.
+ * @details Интерпретатор печатает результат каждого присваивания, а в замерах нужна только скорость разбора.
+ */
+class SilenceOutput {
+public:
+    SilenceOutput() : previous_(std::cout.rdbuf(&null_buffer_)) {}
+    ~SilenceOutput() {
+        std::cout.rdbuf(previous_);
+    }
+
+    SilenceOutput(const SilenceOutput &) = delete;
+    SilenceOutput &operator=(const SilenceOutput &) = delete;
+
+private:
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override {
+            return traits_type::not_eof(c);
+        }
+    };
+
+    NullBuffer null_buffer_;
+    std::streambuf *previous_;
+};
+
+#endif //MADEALGORITHMSHOMEWORK2_SCRIPTGENERATOR_H
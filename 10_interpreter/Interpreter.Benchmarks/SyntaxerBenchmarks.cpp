@@ -0,0 +1,46 @@
+#include "benchmark/benchmark.h"
+
+#include "Interpreter/Lexer.h"
+#include "Interpreter/Syntaxer.h"
+#include "ScriptGenerator.h"
+
+/*
+ * Лексический анализ выполняется один раз до замера, поэтому измеряется только синтаксический анализ
+ * вместе с вычислением значений.
+ */
+
+static void BM_SyntaxerFlat(benchmark::State &state) {
+    SilenceOutput silence;
+    Grammar grammar;
+    auto lexemes = Lexer::parse_code(generate_flat_script(static_cast<size_t>(state.range(0))), grammar);
+    for (auto _: state) {
+        Syntaxer::execute(lexemes, grammar);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lexemes.size()));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SyntaxerFlat)->RangeMultiplier(4)->Range(16, 16 << 10)->Complexity();
+
+static void BM_SyntaxerNested(benchmark::State &state) {
+    SilenceOutput silence;
+    Grammar grammar;
+    auto lexemes = Lexer::parse_code(generate_nested_script(static_cast<size_t>(state.range(0))), grammar);
+    for (auto _: state) {
+        Syntaxer::execute(lexemes, grammar);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lexemes.size()));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SyntaxerNested)->RangeMultiplier(4)->Range(4, 4 << 10)->Complexity();
+
+static void BM_SyntaxerArray(benchmark::State &state) {
+    SilenceOutput silence;
+    Grammar grammar;
+    auto lexemes = Lexer::parse_code(generate_array_script(static_cast<size_t>(state.range(0))), grammar);
+    for (auto _: state) {
+        Syntaxer::execute(lexemes, grammar);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lexemes.size()));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SyntaxerArray)->RangeMultiplier(4)->Range(4, 4 << 10)->Complexity();
@@ -18,10 +18,10 @@ TEST_F(LexerArraysTests, ParseCode_CreateArray) {
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::LEFT_SQUARE_BRACKET);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[3].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[3].get_integer(), 1);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::COMMA);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[5].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[5].get_integer(), 2);
     ASSERT_EQ(lexemes1[6].get_type(), Lexeme::LexemeType::RIGHT_SQUARE_BRACKET);
     ASSERT_EQ(lexemes1[7].get_type(), Lexeme::LexemeType::END);
 }
@@ -39,11 +39,11 @@ TEST_F(LexerArraysTests, ParseCode_ReadByIndex) {
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::LEFT_SQUARE_BRACKET);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[4].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[4].get_integer(), 1);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::RIGHT_SQUARE_BRACKET);
     ASSERT_EQ(lexemes1[6].get_type(), Lexeme::LexemeType::PLUS);
     ASSERT_EQ(lexemes1[7].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[7].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[7].get_integer(), 2);
     ASSERT_EQ(lexemes1[8].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -58,10 +58,10 @@ TEST_F(LexerArraysTests, ParseCode_WriteByIndex) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::LEFT_SQUARE_BRACKET);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[2].get_integer(), 1);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::RIGHT_SQUARE_BRACKET);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[5].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[5].get_integer(), 2);
     ASSERT_EQ(lexemes1[6].get_type(), Lexeme::LexemeType::END);
 }
\ No newline at end of file
@@ -16,14 +16,14 @@ TEST_F(LexerBracketsAndFunctionsTests, ParseCode_BracketsArithmetical) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[2].get_integer(), 2);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::MULTIPLICATION);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::LEFT_CIRCLE_BRACKET);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[5].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[5].get_integer(), 2);
     ASSERT_EQ(lexemes1[6].get_type(), Lexeme::LexemeType::PLUS);
     ASSERT_EQ(lexemes1[7].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[7].get_data().data()), 3);
+    ASSERT_EQ(lexemes1[7].get_integer(), 3);
     ASSERT_EQ(lexemes1[8].get_type(), Lexeme::LexemeType::RIGHT_CIRCLE_BRACKET);
     ASSERT_EQ(lexemes1[9].get_type(), Lexeme::LexemeType::END);
 }
@@ -39,14 +39,14 @@ TEST_F(LexerBracketsAndFunctionsTests, ParseCode_BracketsLogical) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[2].get_data().data()), true);
+    ASSERT_EQ(lexemes1[2].get_bool(), true);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::LOGICAL_AND);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::LEFT_CIRCLE_BRACKET);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[5].get_data().data()), true);
+    ASSERT_EQ(lexemes1[5].get_bool(), true);
     ASSERT_EQ(lexemes1[6].get_type(), Lexeme::LexemeType::LOGICAL_OR);
     ASSERT_EQ(lexemes1[7].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[7].get_data().data()), false);
+    ASSERT_EQ(lexemes1[7].get_bool(), false);
     ASSERT_EQ(lexemes1[8].get_type(), Lexeme::LexemeType::RIGHT_CIRCLE_BRACKET);
     ASSERT_EQ(lexemes1[9].get_type(), Lexeme::LexemeType::END);
 }
@@ -23,10 +23,10 @@ TEST_F(LexerCommonTests, ParseCode_SummingConstants) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[2].get_integer(), 1);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::PLUS);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[4].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[4].get_integer(), 2);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -42,10 +42,10 @@ TEST_F(LexerCommonTests, ParseCode_SummingConstantsSeveralStatements) {
         ASSERT_EQ(lexemes1[0 + i * 6].get_type(), Lexeme::LexemeType::IDENTIFIER);
         ASSERT_EQ(lexemes1[1 + i * 6].get_type(), Lexeme::LexemeType::ASSIGN);
         ASSERT_EQ(lexemes1[2 + i * 6].get_type(), Lexeme::LexemeType::CONSTANT);
-        ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2 + i * 6].get_data().data()), 1);
+        ASSERT_EQ(lexemes1[2 + i * 6].get_integer(), 1);
         ASSERT_EQ(lexemes1[3 + i * 6].get_type(), Lexeme::LexemeType::PLUS);
         ASSERT_EQ(lexemes1[4 + i * 6].get_type(), Lexeme::LexemeType::CONSTANT);
-        ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[4 + i * 6].get_data().data()), 2);
+        ASSERT_EQ(lexemes1[4 + i * 6].get_integer(), 2);
         ASSERT_EQ(lexemes1[5 + i * 6].get_type(), Lexeme::LexemeType::END);
     }
 }
@@ -61,10 +61,10 @@ TEST_F(LexerCommonTests, ParseCode_FloatNumbersParsing) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const float *>(lexemes1[2].get_data().data()), 1.3f);
+    ASSERT_EQ(lexemes1[2].get_float(), 1.3);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::PLUS);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const float *>(lexemes1[4].get_data().data()), 2.5f);
+    ASSERT_EQ(lexemes1[4].get_float(), 2.5);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -109,15 +109,15 @@ TEST_F(LexerCommonTests, ParseCode_MinusMultiplicationDivisionParsing) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const float *>(lexemes1[2].get_data().data()), 1.3f);
+    ASSERT_EQ(lexemes1[2].get_float(), 1.3);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::MULTIPLICATION);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const float *>(lexemes1[4].get_data().data()), 2.5f);
+    ASSERT_EQ(lexemes1[4].get_float(), 2.5);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::MINUS);
     ASSERT_EQ(lexemes1[6].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const float *>(lexemes1[6].get_data().data()), 1.1f);
+    ASSERT_EQ(lexemes1[6].get_float(), 1.1);
     ASSERT_EQ(lexemes1[7].get_type(), Lexeme::LexemeType::DIVISION);
     ASSERT_EQ(lexemes1[8].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const float *>(lexemes1[8].get_data().data()), 2.2f);
+    ASSERT_EQ(lexemes1[8].get_float(), 2.2);
     ASSERT_EQ(lexemes1[9].get_type(), Lexeme::LexemeType::END);
 }
\ No newline at end of file
@@ -16,10 +16,10 @@ TEST_F(LexerComparisonTests, ParseCode_Less) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[2].get_integer(), 1);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::LESS);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[4].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[4].get_integer(), 2);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -34,10 +34,10 @@ TEST_F(LexerComparisonTests, ParseCode_Greater) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[2].get_integer(), 1);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::GREATER);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[4].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[4].get_integer(), 2);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -52,10 +52,10 @@ TEST_F(LexerComparisonTests, ParseCode_Equal) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[2].get_integer(), 1);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::EQUAL);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[4].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[4].get_integer(), 2);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -70,10 +70,10 @@ TEST_F(LexerComparisonTests, ParseCode_NotEqual) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[2].get_integer(), 1);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::NOT_EQUAL);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[4].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[4].get_integer(), 2);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -88,10 +88,10 @@ TEST_F(LexerComparisonTests, ParseCode_LessOrEqual) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[2].get_integer(), 1);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::LESS_OR_EQUAL);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[4].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[4].get_integer(), 2);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -106,9 +106,9 @@ TEST_F(LexerComparisonTests, ParseCode_GreaterOrEqual) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[2].get_data().data()), 1);
+    ASSERT_EQ(lexemes1[2].get_integer(), 1);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::GREATER_OR_EQUAL);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexemes1[4].get_data().data()), 2);
+    ASSERT_EQ(lexemes1[4].get_integer(), 2);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
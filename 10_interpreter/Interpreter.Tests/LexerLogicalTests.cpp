@@ -16,10 +16,10 @@ TEST_F(LexerLogicalTests, ParseCode_TrueAndFalse) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[2].get_data().data()), true);
+    ASSERT_EQ(lexemes1[2].get_bool(), true);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::LOGICAL_AND);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[4].get_data().data()), false);
+    ASSERT_EQ(lexemes1[4].get_bool(), false);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -34,10 +34,10 @@ TEST_F(LexerLogicalTests, ParseCode_TrueOrFalse) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[2].get_data().data()), true);
+    ASSERT_EQ(lexemes1[2].get_bool(), true);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::LOGICAL_OR);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[4].get_data().data()), false);
+    ASSERT_EQ(lexemes1[4].get_bool(), false);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -52,10 +52,10 @@ TEST_F(LexerLogicalTests, ParseCode_TrueXorFalse) {
     ASSERT_EQ(lexemes1[0].get_type(), Lexeme::LexemeType::IDENTIFIER);
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[2].get_data().data()), true);
+    ASSERT_EQ(lexemes1[2].get_bool(), true);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::LOGICAL_XOR);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[4].get_data().data()), false);
+    ASSERT_EQ(lexemes1[4].get_bool(), false);
     ASSERT_EQ(lexemes1[5].get_type(), Lexeme::LexemeType::END);
 }
 
@@ -71,6 +71,6 @@ TEST_F(LexerLogicalTests, ParseCode_NotTrue) {
     ASSERT_EQ(lexemes1[1].get_type(), Lexeme::LexemeType::ASSIGN);
     ASSERT_EQ(lexemes1[2].get_type(), Lexeme::LexemeType::LOGICAL_NOT);
     ASSERT_EQ(lexemes1[3].get_type(), Lexeme::LexemeType::CONSTANT);
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexemes1[3].get_data().data()), true);
+    ASSERT_EQ(lexemes1[3].get_bool(), true);
     ASSERT_EQ(lexemes1[4].get_type(), Lexeme::LexemeType::END);
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+
+#include "Interpreter/Lexer.h"
+#include "Interpreter/Lexeme.h"
+
+class LexerTokenizeTests : public ::testing::Test {
+};
+
+TEST_F(LexerTokenizeTests, Tokenize_ViewsIntoSource) {
+//arrange
+    const std::string code1 = "abc = 12 + 2.5; ";
+    Grammar grammar;
+//act
+    auto tokens1 = Lexer::tokenize(code1, grammar);
+//assert
+    ASSERT_EQ(tokens1.size(), 6);
+    ASSERT_EQ(tokens1[0].text, "abc");
+    ASSERT_EQ(tokens1[0].text.data(), code1.data());
+    ASSERT_EQ(tokens1[0].type, Lexeme::LexemeType::IDENTIFIER);
+    ASSERT_EQ(tokens1[1].type, Lexeme::LexemeType::ASSIGN);
+    ASSERT_EQ(tokens1[2].type, Lexeme::LexemeType::CONSTANT);
+    ASSERT_EQ(tokens1[2].type_value, Lexeme::ValueType::INTEGER);
+    ASSERT_EQ(tokens1[2].value.integer, 12);
+    ASSERT_EQ(tokens1[3].type, Lexeme::LexemeType::PLUS);
+    ASSERT_EQ(tokens1[4].type_value, Lexeme::ValueType::FLOAT);
+    ASSERT_EQ(tokens1[4].value.floating, 2.5);
+    ASSERT_EQ(tokens1[5].type, Lexeme::LexemeType::END);
+}
+
+TEST_F(LexerTokenizeTests, Tokenize_Keywords) {
+//arrange
+    const std::string code1 = "a = !true || sqrt(PI) >= 1.0; ";
+    Grammar grammar;
+//act
+    auto tokens1 = Lexer::tokenize(code1, grammar);
+//assert
+    ASSERT_EQ(tokens1.size(), 12);
+    ASSERT_EQ(tokens1[2].type, Lexeme::LexemeType::LOGICAL_NOT);
+    ASSERT_EQ(tokens1[3].type, Lexeme::LexemeType::CONSTANT);
+    ASSERT_EQ(tokens1[3].type_value, Lexeme::ValueType::BOOL);
+    ASSERT_EQ(tokens1[3].value.boolean, true);
+    ASSERT_EQ(tokens1[4].type, Lexeme::LexemeType::LOGICAL_OR);
+    ASSERT_EQ(tokens1[5].type, Lexeme::LexemeType::IDENTIFIER);
+    ASSERT_EQ(tokens1[6].type, Lexeme::LexemeType::LEFT_CIRCLE_BRACKET);
+    ASSERT_EQ(tokens1[7].type, Lexeme::LexemeType::CONSTANT);
+    ASSERT_EQ(tokens1[8].type, Lexeme::LexemeType::RIGHT_CIRCLE_BRACKET);
+    ASSERT_EQ(tokens1[9].type, Lexeme::LexemeType::GREATER_OR_EQUAL);
+}
+
+TEST_F(LexerTokenizeTests, Tokenize_UnknownLexeme) {
+//arrange
+    const std::string code1 = "a = 1 +- 2; ";
+    Grammar grammar;
+//act
+//assert
+    ASSERT_THROW(Lexer::tokenize(code1, grammar), std::runtime_error);
+}
@@ -0,0 +1,160 @@
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "Interpreter/Lexer.h"
+#include "Interpreter/Syntaxer.h"
+#include "Interpreter/Optimizer.h"
+#include "Interpreter/VirtualMachine.h"
+
+class OptimizerTests : public ::testing::Test {
+};
+
+TEST_F(OptimizerTests, Optimize_FoldConstants) {
+//arrange
+    const std::string code1 = "a = square(3) + 2 * 4; ";
+    Grammar grammar;
+    auto program = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+//act
+    Optimizer::optimize(program, grammar);
+    VirtualMachine::run(program, grammar);
+//assert
+    ASSERT_EQ(program.get_code().size(), 2);
+    ASSERT_EQ(program.get_code()[0].code, Program::OpCode::PUSH);
+    ASSERT_EQ(program.get_code()[1].code, Program::OpCode::STORE);
+    auto lexeme = grammar.find_lexeme("a");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_integer(), 17);
+}
+
+TEST_F(OptimizerTests, Optimize_KeepInvalidOperations) {
+//arrange
+    const std::string code1 = "a = 1 + 1.0; ";
+    const std::string code2 = "b = 1 / 0; ";
+    Grammar grammar;
+    auto program1 = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+    auto program2 = Syntaxer::compile(Lexer::parse_code(code2, grammar), grammar);
+//act
+    Optimizer::optimize(program1, grammar);
+    Optimizer::optimize(program2, grammar);
+//assert
+    ASSERT_EQ(program1.get_code().size(), 4);
+    ASSERT_EQ(program1.get_code()[2].code, Program::OpCode::BINARY);
+    ASSERT_EQ(program2.get_code().size(), 4);
+    ASSERT_EQ(program2.get_code()[2].code, Program::OpCode::BINARY);
+}
+
+TEST_F(OptimizerTests, Optimize_StrengthReduction) {
+//arrange
+    const std::string code1 = "a = 5; b = a * 2 + 0; ";
+    Grammar grammar;
+    auto program = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+//act
+    Optimizer::optimize(program, grammar);
+    VirtualMachine::run(program, grammar);
+//assert
+    ASSERT_EQ(program.get_code().size(), 6);
+    ASSERT_EQ(program.get_code()[3].code, Program::OpCode::DUP);
+    ASSERT_EQ(program.get_lexemes()[program.get_code()[4].action].get_code(), "+");
+    auto lexeme = grammar.find_lexeme("b");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_integer(), 10);
+}
+
+TEST_F(OptimizerTests, Optimize_UnknownTypeNotSimplified) {
+//arrange
+    const std::string code1 = "a = 5; ";
+    const std::string code2 = "b = a * 2 + 0; ";
+    Grammar grammar;
+    auto program1 = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+    auto program2 = Syntaxer::compile(Lexer::parse_code(code2, grammar), grammar);
+//act
+    Optimizer::optimize(program2, grammar);
+    VirtualMachine::run(program1, grammar);
+    VirtualMachine::run(program2, grammar);
+//assert
+    ASSERT_EQ(program2.get_code().size(), 6);
+    ASSERT_EQ(program2.get_code()[2].code, Program::OpCode::BINARY);
+    ASSERT_EQ(program2.get_code()[4].code, Program::OpCode::BINARY);
+    ASSERT_EQ(grammar.find_lexeme("b").value().get_integer(), 10);
+}
+
+TEST_F(OptimizerTests, Optimize_KeepTypeErrorsForFloat) {
+//arrange
+    const std::string code1 = "x = 1.5; y = x * 2; z = x + 0; ";
+    Grammar grammar;
+    auto program = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+//act
+    Optimizer::optimize(program, grammar);
+    testing::internal::CaptureStderr();
+    VirtualMachine::run(program, grammar);
+    auto errors = testing::internal::GetCapturedStderr();
+//assert
+    ASSERT_EQ(program.get_code()[4].code, Program::OpCode::BINARY);
+    ASSERT_EQ(program.get_code()[8].code, Program::OpCode::BINARY);
+    ASSERT_EQ(errors, "Operands must be of the same type.\nOperands must be of the same type.\n");
+    ASSERT_EQ(grammar.find_lexeme("y").value().get_float(), 1.5);
+}
+
+TEST_F(OptimizerTests, Optimize_KeepTypeErrorsForBool) {
+//arrange
+    const std::string code1 = "b = true; c = b * 1; d = b + 0; ";
+    Grammar grammar;
+    auto program = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+//act
+    Optimizer::optimize(program, grammar);
+    testing::internal::CaptureStderr();
+    VirtualMachine::run(program, grammar);
+    auto errors = testing::internal::GetCapturedStderr();
+//assert
+    ASSERT_EQ(program.get_code()[4].code, Program::OpCode::BINARY);
+    ASSERT_EQ(program.get_code()[8].code, Program::OpCode::BINARY);
+    ASSERT_EQ(errors, "Operands must be of the same type.\nOperands must be of the same type.\n");
+}
+
+TEST_F(OptimizerTests, Optimize_KeepTypeErrorsForArray) {
+//arrange
+    const std::string code1 = "a = [1.5, 2.5]; c = a * 1; d = a * 2; ";
+    Grammar grammar;
+    auto program = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+//act
+    Optimizer::optimize(program, grammar);
+    testing::internal::CaptureStderr();
+    VirtualMachine::run(program, grammar);
+    auto errors = testing::internal::GetCapturedStderr();
+//assert
+    ASSERT_EQ(errors, "Operands must be of the same type.\nOperands must be of the same type.\n");
+    const auto &code = program.get_code();
+    ASSERT_EQ(std::count_if(code.begin(), code.end(), [](const auto &instruction) {
+        return instruction.code == Program::OpCode::DUP;
+    }), 0);
+}
+
+TEST_F(OptimizerTests, Optimize_DeadStores) {
+//arrange
+    const std::string code1 = "a = 1; b = a; a = 2; a = 3; ";
+    Grammar grammar;
+    auto program = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+//act
+    Optimizer::optimize(program, grammar);
+    VirtualMachine::run(program, grammar);
+//assert
+    const auto &code = program.get_code();
+    ASSERT_EQ(code[1].code, Program::OpCode::STORE);
+    ASSERT_EQ(code[3].code, Program::OpCode::STORE);
+    ASSERT_EQ(code[5].code, Program::OpCode::ECHO);
+    ASSERT_EQ(code[7].code, Program::OpCode::STORE);
+    ASSERT_EQ(grammar.find_lexeme("a").value().get_integer(), 3);
+    ASSERT_EQ(grammar.find_lexeme("b").value().get_integer(), 1);
+}
+
+TEST_F(OptimizerTests, Optimize_UnusedExpressions) {
+//arrange
+    const std::string code1 = "a = 1; a; 2 + 3; ";
+    Grammar grammar;
+    auto program = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+//act
+    Optimizer::optimize(program, grammar);
+//assert
+    ASSERT_EQ(program.get_code().size(), 2);
+}
@@ -0,0 +1,59 @@
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "Interpreter/Lexer.h"
+#include "Interpreter/Syntaxer.h"
+#include "Interpreter/Profiler.h"
+
+class ProfilerTests : public ::testing::Test {
+};
+
+TEST_F(ProfilerTests, Execute_CountRulesAndTokens) {
+//arrange
+    const std::string code1 = "a = 1 + 2; b = 2 * 3; ";
+    Grammar grammar;
+    Profiler profiler;
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+//act
+    profiler.count_tokens(lexemes1);
+    Syntaxer::execute(lexemes1, grammar, &profiler);
+//assert
+    ASSERT_EQ(grammar.find_lexeme("b").value().get_integer(), 6);
+    ASSERT_EQ(profiler.get_token_count(Lexeme::LexemeType::IDENTIFIER), 2);
+    ASSERT_EQ(profiler.get_token_count(Lexeme::LexemeType::CONSTANT), 4);
+    ASSERT_EQ(profiler.get_token_count(Lexeme::LexemeType::END), 2);
+    ASSERT_EQ(profiler.get_token_count(Lexeme::LexemeType::COMMA), 0);
+    size_t assignments = 0;
+    size_t total = 0;
+    for (const auto &rule: profiler.get_rules()) {
+        if (rule.from == std::vector<Lexeme::LexemeType>{Lexeme::LexemeType::IDENTIFIER,
+                                                        Lexeme::LexemeType::ASSIGN,
+                                                        Lexeme::LexemeType::EXPRESSION}) {
+            assignments = rule.hits;
+        }
+        total += rule.hits;
+    }
+    ASSERT_EQ(assignments, 2);
+    ASSERT_EQ(total, profiler.get_lookups());
+    ASSERT_GE(profiler.get_max_depth(), 3);
+}
+
+TEST_F(ProfilerTests, PrintJson_ContainsAllSections) {
+//arrange
+    const std::string code1 = "a = [1, 2]; ";
+    Grammar grammar;
+    Profiler profiler;
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+    profiler.count_tokens(lexemes1);
+    Syntaxer::compile(lexemes1, grammar, &profiler);
+    std::stringstream out;
+//act
+    profiler.print_json(out);
+//assert
+    auto json = out.str();
+    ASSERT_EQ(json.front(), '{');
+    ASSERT_NE(json.find("\"rule\": \"LIST COMMA EXPRESSION\", \"hits\": 1"), std::string::npos);
+    ASSERT_NE(json.find("\"max_stack_depth\": "), std::string::npos);
+    ASSERT_NE(json.find("\"COMMA\": 1"), std::string::npos);
+}
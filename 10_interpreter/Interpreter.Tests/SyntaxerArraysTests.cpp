@@ -24,7 +24,7 @@ TEST_F(SyntaxerArraysTests, Execute_CreateAndUsingArray) {
 //assert
     auto lexeme = grammar.find_lexeme("b");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexeme.value().get_data().data()), 4);
+    ASSERT_EQ(lexeme.value().get_integer(), 4);
 }
 
 TEST_F(SyntaxerArraysTests, Execute_ReadByIndex) {
@@ -40,7 +40,7 @@ TEST_F(SyntaxerArraysTests, Execute_ReadByIndex) {
 //assert
     auto lexeme = grammar.find_lexeme("b");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexeme.value().get_data().data()), 22);
+    ASSERT_EQ(lexeme.value().get_integer(), 22);
 }
 
 TEST_F(SyntaxerArraysTests, Execute_WriteByIndex) {
@@ -59,5 +59,101 @@ TEST_F(SyntaxerArraysTests, Execute_WriteByIndex) {
 //assert
     auto lexeme = grammar.find_lexeme("b");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexeme.value().get_data().data()), 11);
-}
\ No newline at end of file
+    ASSERT_EQ(lexeme.value().get_integer(), 11);
+}
+TEST_F(SyntaxerArraysTests, Execute_CopyIsIndependent) {
+//arrange
+    const std::string code1 = "a = [1, 2, 3, 4]; ";
+    const std::string code2 = "b = a; ";
+    const std::string code3 = "a[1] = 11; ";
+    Grammar grammar;
+//act
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+    Syntaxer::execute(lexemes1, grammar);
+    auto lexemes2 = Lexer::parse_code(code2, grammar);
+    Syntaxer::execute(lexemes2, grammar);
+    auto lexemes3 = Lexer::parse_code(code3, grammar);
+    Syntaxer::execute(lexemes3, grammar);
+//assert
+    auto lexeme_a = grammar.find_lexeme("a");
+    auto lexeme_b = grammar.find_lexeme("b");
+    ASSERT_TRUE(lexeme_a.has_value());
+    ASSERT_TRUE(lexeme_b.has_value());
+    auto index = Lexeme(Lexeme::LexemeType::CONSTANT, "1", Lexeme::ValueType::INTEGER, 1);
+    ASSERT_EQ(lexeme_a.value().get_element(index).value().get_integer(), 11);
+    ASSERT_EQ(lexeme_b.value().get_element(index).value().get_integer(), 2);
+}
+
+TEST_F(SyntaxerArraysTests, Execute_ElementwiseArithmetic) {
+//arrange
+    const std::string code1 = "a = [1, 2, 3]; b = [4, 5, 6]; ";
+    const std::string code2 = "c = a * b - 1; ";
+    Grammar grammar;
+//act
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+    Syntaxer::execute(lexemes1, grammar);
+    auto lexemes2 = Lexer::parse_code(code2, grammar);
+    Syntaxer::execute(lexemes2, grammar);
+//assert
+    auto lexeme = grammar.find_lexeme("c");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_type_subvalue(), Lexeme::ValueType::INTEGER);
+    ASSERT_EQ(lexeme.value().get_size(), 3);
+    ASSERT_EQ(lexeme.value().get_array()[0].integer, 3);
+    ASSERT_EQ(lexeme.value().get_array()[1].integer, 9);
+    ASSERT_EQ(lexeme.value().get_array()[2].integer, 17);
+}
+
+TEST_F(SyntaxerArraysTests, Execute_ElementwiseComparison) {
+//arrange
+    const std::string code1 = "a = [1.5, 2.5, 3.5]; ";
+    const std::string code2 = "b = a > 2.0; ";
+    Grammar grammar;
+//act
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+    Syntaxer::execute(lexemes1, grammar);
+    auto lexemes2 = Lexer::parse_code(code2, grammar);
+    Syntaxer::execute(lexemes2, grammar);
+//assert
+    auto lexeme = grammar.find_lexeme("b");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_type_subvalue(), Lexeme::ValueType::BOOL);
+    ASSERT_EQ(lexeme.value().get_array()[0].boolean, false);
+    ASSERT_EQ(lexeme.value().get_array()[1].boolean, true);
+    ASSERT_EQ(lexeme.value().get_array()[2].boolean, true);
+}
+
+TEST_F(SyntaxerArraysTests, Execute_Reductions) {
+//arrange
+    const std::string code1 = "a = [4, 2, 7, 1]; ";
+    const std::string code2 = "s = sum(a); ";
+    const std::string code3 = "l = min(a); ";
+    const std::string code4 = "h = max(a); ";
+    Grammar grammar;
+//act
+    for (const auto &code: {code1, code2, code3, code4}) {
+        auto lexemes = Lexer::parse_code(code, grammar);
+        Syntaxer::execute(lexemes, grammar);
+    }
+//assert
+    ASSERT_EQ(grammar.find_lexeme("s").value().get_integer(), 14);
+    ASSERT_EQ(grammar.find_lexeme("l").value().get_integer(), 1);
+    ASSERT_EQ(grammar.find_lexeme("h").value().get_integer(), 7);
+}
+
+TEST_F(SyntaxerArraysTests, Execute_DifferentLengths) {
+//arrange
+    const std::string code1 = "a = [1, 2, 3]; b = [1, 2]; ";
+    const std::string code2 = "c = a + b; ";
+    Grammar grammar;
+//act
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+    Syntaxer::execute(lexemes1, grammar);
+    auto lexemes2 = Lexer::parse_code(code2, grammar);
+    Syntaxer::execute(lexemes2, grammar);
+//assert
+    auto lexeme = grammar.find_lexeme("c");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_size(), 3);
+    ASSERT_EQ(lexeme.value().get_array()[2].integer, 3);
+}
@@ -20,7 +20,7 @@ TEST_F(SyntaxerCommonTests, Execute_ConstPlusConst) {
 //assert
     auto lexeme = grammar.find_lexeme("a");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexeme.value().get_data().data()), 3);
+    ASSERT_EQ(lexeme.value().get_integer(), 3);
 }
 
 TEST_F(SyntaxerCommonTests, Execute_ReusableVariables) {
@@ -39,7 +39,7 @@ TEST_F(SyntaxerCommonTests, Execute_ReusableVariables) {
 //assert
     auto lexeme = grammar.find_lexeme("c");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexeme.value().get_data().data()), 8);
+    ASSERT_EQ(lexeme.value().get_integer(), 8);
 }
 
 TEST_F(SyntaxerCommonTests, Execute_MinusMultiplicationDivision) {
@@ -52,5 +52,38 @@ TEST_F(SyntaxerCommonTests, Execute_MinusMultiplicationDivision) {
 //assert
     auto lexeme = grammar.find_lexeme("a");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const float *>(lexeme.value().get_data().data()), 2.75f);
-}
\ No newline at end of file
+    ASSERT_EQ(lexeme.value().get_float(), 2.75);
+}
+
+TEST_F(SyntaxerCommonTests, Execute_LongStatement) {
+//arrange
+    std::string code1 = "a = 1";
+    for (auto i = 0; i < 2000; ++i) {
+        code1 += " + 1";
+    }
+    code1 += "; ";
+    Grammar grammar;
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+//act
+    Syntaxer::execute(lexemes1, grammar);
+//assert
+    auto lexeme = grammar.find_lexeme("a");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_integer(), 2001);
+}
+
+TEST_F(SyntaxerCommonTests, Execute_WideNumbers) {
+//arrange
+    const std::string code1 = "a = 3000000000 * 4 + 1; ";
+    const std::string code2 = "b = 0.1 + 0.2; ";
+    const std::string code3 = "c = 9007199254740993 - 1; ";
+    Grammar grammar;
+//act
+    Syntaxer::execute(Lexer::parse_code(code1, grammar), grammar);
+    Syntaxer::execute(Lexer::parse_code(code2, grammar), grammar);
+    Syntaxer::execute(Lexer::parse_code(code3, grammar), grammar);
+//assert
+    ASSERT_EQ(grammar.find_lexeme("a").value().get_integer(), 12000000001LL);
+    ASSERT_EQ(grammar.find_lexeme("b").value().get_float(), 0.1 + 0.2);
+    ASSERT_EQ(grammar.find_lexeme("c").value().get_integer(), 9007199254740992LL);
+}
@@ -24,10 +24,10 @@ TEST_F(SyntaxerComparisonTests, Execute_ComparisonsLessGreater) {
 //assert
     auto lexeme = grammar.find_lexeme("x");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), true);
+    ASSERT_EQ(lexeme.value().get_bool(), true);
     lexeme = grammar.find_lexeme("y");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), false);
+    ASSERT_EQ(lexeme.value().get_bool(), false);
 }
 
 TEST_F(SyntaxerComparisonTests, Execute_ComparisonsEqualOrNotEqual) {
@@ -43,10 +43,10 @@ TEST_F(SyntaxerComparisonTests, Execute_ComparisonsEqualOrNotEqual) {
 //assert
     auto lexeme = grammar.find_lexeme("x");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), true);
+    ASSERT_EQ(lexeme.value().get_bool(), true);
     lexeme = grammar.find_lexeme("y");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), false);
+    ASSERT_EQ(lexeme.value().get_bool(), false);
 }
 
 TEST_F(SyntaxerComparisonTests, Execute_ComparisonsLessOrEqual) {
@@ -65,13 +65,13 @@ TEST_F(SyntaxerComparisonTests, Execute_ComparisonsLessOrEqual) {
 //assert
     auto lexeme = grammar.find_lexeme("x");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), true);
+    ASSERT_EQ(lexeme.value().get_bool(), true);
     lexeme = grammar.find_lexeme("y");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), true);
+    ASSERT_EQ(lexeme.value().get_bool(), true);
     lexeme = grammar.find_lexeme("z");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), false);
+    ASSERT_EQ(lexeme.value().get_bool(), false);
 }
 
 TEST_F(SyntaxerComparisonTests, Execute_ComparisonsGreaterOrEqual) {
@@ -90,11 +90,11 @@ TEST_F(SyntaxerComparisonTests, Execute_ComparisonsGreaterOrEqual) {
 //assert
     auto lexeme = grammar.find_lexeme("x");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), false);
+    ASSERT_EQ(lexeme.value().get_bool(), false);
     lexeme = grammar.find_lexeme("y");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), true);
+    ASSERT_EQ(lexeme.value().get_bool(), true);
     lexeme = grammar.find_lexeme("z");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), true);
+    ASSERT_EQ(lexeme.value().get_bool(), true);
 }
\ No newline at end of file
@@ -24,8 +24,8 @@ TEST_F(SyntaxerFunctionsTests, Execute_CallingFunction) {
 //assert
     auto lexeme = grammar.find_lexeme("a");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexeme.value().get_data().data()), 9);
+    ASSERT_EQ(lexeme.value().get_integer(), 9);
     lexeme = grammar.find_lexeme("b");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const float *>(lexeme.value().get_data().data()), 2.5f);
+    ASSERT_EQ(lexeme.value().get_float(), 2.5);
 }
@@ -27,11 +27,11 @@ TEST_F(SyntaxerLogicalTests, Execute_LogicalOperations) {
 //assert
     auto lexeme = grammar.find_lexeme("x");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), false);
+    ASSERT_EQ(lexeme.value().get_bool(), false);
     lexeme = grammar.find_lexeme("y");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), true);
+    ASSERT_EQ(lexeme.value().get_bool(), true);
     lexeme = grammar.find_lexeme("z");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const bool *>(lexeme.value().get_data().data()), false);
+    ASSERT_EQ(lexeme.value().get_bool(), false);
 }
@@ -26,7 +26,7 @@ TEST_F(SyntaxerPriorityTests, Execute_PlusMultiplication) {
 //assert
     auto lexeme = grammar.find_lexeme("c");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexeme.value().get_data().data()), 28);
+    ASSERT_EQ(lexeme.value().get_integer(), 28);
 }
 
 TEST_F(SyntaxerPriorityTests, Execute_MinusMultiplicationDivision) {
@@ -39,7 +39,7 @@ TEST_F(SyntaxerPriorityTests, Execute_MinusMultiplicationDivision) {
 //assert
     auto lexeme = grammar.find_lexeme("a");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const float *>(lexeme.value().get_data().data()), 2.75f);
+    ASSERT_EQ(lexeme.value().get_float(), 2.75);
 }
 
 TEST_F(SyntaxerPriorityTests, Execute_Brackets) {
@@ -55,8 +55,32 @@ TEST_F(SyntaxerPriorityTests, Execute_Brackets) {
 //assert
     auto lexeme = grammar.find_lexeme("a");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexeme.value().get_data().data()), 10);
+    ASSERT_EQ(lexeme.value().get_integer(), 10);
     lexeme = grammar.find_lexeme("b");
     ASSERT_TRUE(lexeme.has_value());
-    ASSERT_EQ(*reinterpret_cast<const int32_t *>(lexeme.value().get_data().data()), 10);
-}
\ No newline at end of file
+    ASSERT_EQ(lexeme.value().get_integer(), 10);
+}
+
+TEST_F(SyntaxerPriorityTests, Execute_DeepBrackets) {
+//arrange
+    const size_t depth = 2000;
+    std::string code1 = "a = ";
+    for (size_t i = 0; i < depth; ++i) {
+        code1 += "1 + (";
+    }
+    code1 += "1" + std::string(depth, ')') + "; ";
+    const std::string code2 = "b = ((2)) * ((3 + 4)); ";
+    Grammar grammar;
+//act
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+    Syntaxer::execute(lexemes1, grammar);
+    auto lexemes2 = Lexer::parse_code(code2, grammar);
+    Syntaxer::execute(lexemes2, grammar);
+//assert
+    auto lexeme = grammar.find_lexeme("a");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_integer(), static_cast<int32_t>(depth + 1));
+    lexeme = grammar.find_lexeme("b");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_integer(), 14);
+}
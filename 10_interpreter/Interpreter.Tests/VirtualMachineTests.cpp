@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+
+#include "Interpreter/Lexer.h"
+#include "Interpreter/Syntaxer.h"
+#include "Interpreter/VirtualMachine.h"
+
+class VirtualMachineTests : public ::testing::Test {
+};
+
+TEST_F(VirtualMachineTests, Run_ConstPlusConst) {
+//arrange
+    const std::string code1 = "a = 1 + 2; ";
+    Grammar grammar;
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+    auto program = Syntaxer::compile(lexemes1, grammar);
+//act
+    VirtualMachine::run(program, grammar);
+//assert
+    auto lexeme = grammar.find_lexeme("a");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_integer(), 3);
+}
+
+TEST_F(VirtualMachineTests, Compile_DoesNotExecute) {
+//arrange
+    const std::string code1 = "a = 1 + 2; ";
+    Grammar grammar;
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+//act
+    auto program = Syntaxer::compile(lexemes1, grammar);
+//assert
+    ASSERT_FALSE(grammar.find_lexeme("a").has_value());
+    ASSERT_EQ(program.get_code().size(), 4);
+}
+
+TEST_F(VirtualMachineTests, Run_ProgramManyTimes) {
+//arrange
+    const std::string code1 = "a = 0; ";
+    const std::string code2 = "a = a + 1; ";
+    Grammar grammar;
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+    Syntaxer::execute(lexemes1, grammar);
+    auto lexemes2 = Lexer::parse_code(code2, grammar);
+    auto program = Syntaxer::compile(lexemes2, grammar);
+//act
+    for (auto i = 0; i < 10; ++i) {
+        VirtualMachine::run(program, grammar);
+    }
+//assert
+    auto lexeme = grammar.find_lexeme("a");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_integer(), 10);
+}
+
+TEST_F(VirtualMachineTests, Run_PriorityAndFunctions) {
+//arrange
+    const std::string code1 = "a = (1.0 + 3.0) * sqrt(4.0) - 1.0 / 2.0; ";
+    Grammar grammar;
+    auto lexemes1 = Lexer::parse_code(code1, grammar);
+    auto program = Syntaxer::compile(lexemes1, grammar);
+//act
+    VirtualMachine::run(program, grammar);
+//assert
+    auto lexeme = grammar.find_lexeme("a");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_float(), 7.5);
+}
+
+TEST_F(VirtualMachineTests, Run_Arrays) {
+//arrange
+    const std::string code1 = "a = [1, 2, 3]; ";
+    const std::string code2 = "a[1] = 5; ";
+    const std::string code3 = "b = a[1] + a[2]; ";
+    Grammar grammar;
+    auto program1 = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+    auto program2 = Syntaxer::compile(Lexer::parse_code(code2, grammar), grammar);
+    auto program3 = Syntaxer::compile(Lexer::parse_code(code3, grammar), grammar);
+//act
+    VirtualMachine::run(program1, grammar);
+    VirtualMachine::run(program2, grammar);
+    VirtualMachine::run(program3, grammar);
+//assert
+    auto lexeme = grammar.find_lexeme("b");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_integer(), 8);
+}
+
+TEST_F(VirtualMachineTests, Run_WholeScript) {
+//arrange
+    const std::string code1 = "a = [1, 2, 3];\nd = 1; a[d] = 5;\nb = a[1] + a[2];\n";
+    Grammar grammar;
+    auto program = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+//act
+    VirtualMachine::run(program, grammar);
+//assert
+    auto lexeme = grammar.find_lexeme("b");
+    ASSERT_TRUE(lexeme.has_value());
+    ASSERT_EQ(lexeme.value().get_integer(), 8);
+}
+
+TEST_F(VirtualMachineTests, Run_SharedVariableSlots) {
+//arrange
+    const std::string code1 = "c = a + b; ";
+    const std::string code2 = "b = 1; a = 2; ";
+    Grammar grammar;
+    auto program1 = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+    auto program2 = Syntaxer::compile(Lexer::parse_code(code2, grammar), grammar);
+//act
+    VirtualMachine::run(program2, grammar);
+    auto undefined = grammar.find_lexeme("c");
+    VirtualMachine::run(program1, grammar);
+//assert
+    ASSERT_FALSE(undefined.has_value());
+    const auto &variables = grammar.get_environment();
+    ASSERT_EQ(variables.find_slot("b"), 0);
+    ASSERT_EQ(variables.find_slot("a"), 1);
+    ASSERT_EQ(variables.find_slot("c"), 2);
+    ASSERT_EQ(variables.at(2).get_integer(), 3);
+    ASSERT_EQ(grammar.find_lexeme("c").value().get_integer(), 3);
+}
+
+TEST_F(VirtualMachineTests, Run_ContinueAfterIndexOutOfRange) {
+//arrange
+    const std::string code1 = "a = [1, 2]; q = a[7] + a[0]; r = 5; a[9] = 3; s = 6; ";
+    Grammar grammar;
+    auto program = Syntaxer::compile(Lexer::parse_code(code1, grammar), grammar);
+//act
+    testing::internal::CaptureStderr();
+    VirtualMachine::run(program, grammar);
+    auto errors = testing::internal::GetCapturedStderr();
+//assert
+    ASSERT_FALSE(grammar.find_lexeme("q").has_value());
+    ASSERT_EQ(grammar.find_lexeme("r").value().get_integer(), 5);
+    ASSERT_EQ(grammar.find_lexeme("s").value().get_integer(), 6);
+    ASSERT_EQ(errors, "Index out of range.\nIndex out of range.\n");
+}
@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+
+#include "Interpreter/WorkerPool.h"
+
+class WorkerPoolTests : public ::testing::Test {
+};
+
+TEST_F(WorkerPoolTests, Run_IndependentSessions) {
+//arrange
+    std::vector<std::string> scripts;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 64; ++i) {
+        scripts.push_back("a = " + std::to_string(i) + "; m = [a, a]; b = sum(m) + 1; ");
+        expected.push_back("\ta = " + std::to_string(i) + "\n" +
+                           "\tm = array[ " + std::to_string(i) + " " + std::to_string(i) + " ]\n" +
+                           "\tb = " + std::to_string(2 * i + 1) + "\n");
+    }
+//act
+    auto results = WorkerPool::run(scripts, 4);
+//assert
+    ASSERT_EQ(results.size(), scripts.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_TRUE(results[i].success);
+        ASSERT_EQ(results[i].output, expected[i]);
+    }
+}
+
+TEST_F(WorkerPoolTests, Run_SessionsDoNotShareVariables) {
+//arrange
+    std::vector<std::string> scripts = {"a = 1; ", "b = a; "};
+//act
+    auto results = WorkerPool::run(scripts, 2);
+//assert
+    ASSERT_EQ(results[0].output, "\ta = 1\n");
+    ASSERT_EQ(results[1].output, "\tb\n");
+}
+
+TEST_F(WorkerPoolTests, Run_MergeProfiles) {
+//arrange
+    std::vector<std::string> scripts(8, "a = 1 + 2; b = a * 3; ");
+    Profiler profiler;
+//act
+    auto results = WorkerPool::run(scripts, 3, Language::get_shared(), &profiler);
+//assert
+    ASSERT_EQ(profiler.get_token_count(Lexeme::LexemeType::IDENTIFIER), 3 * scripts.size());
+    ASSERT_EQ(profiler.get_token_count(Lexeme::LexemeType::END), 2 * scripts.size());
+    size_t assignments = 0;
+    size_t total = 0;
+    for (const auto &rule: profiler.get_rules()) {
+        if (rule.from == std::vector<Lexeme::LexemeType>{Lexeme::LexemeType::IDENTIFIER,
+                                                        Lexeme::LexemeType::ASSIGN,
+                                                        Lexeme::LexemeType::EXPRESSION}) {
+            assignments = rule.hits;
+        }
+        total += rule.hits;
+    }
+    ASSERT_EQ(assignments, 2 * scripts.size());
+    ASSERT_EQ(total, profiler.get_lookups());
+}
@@ -41,10 +41,14 @@ bool Convolution::match(const std::vector<Lexeme::LexemeType> &pattern) const {
     return (pattern.size() == from_.size()) && starts_with(pattern);
 }
 
-void Convolution::apply(std::vector<Lexeme> &lexemes, Grammar &grammar) {
+void Convolution::apply(std::vector<Lexeme> &lexemes, Grammar &grammar) const {
     action_(lexemes, grammar);
 }
 
+void Convolution::compile(std::vector<Lexeme> &lexemes, Program &program) const {
+    compile_(lexemes, program);
+}
+
 void Convolution::debug_print() const {
     std::cerr << "Convolution of a sequence: ";
     for (auto type: from_) {
@@ -7,6 +7,7 @@
 
 #include "Lexeme.h"
 #include "Grammar.h"
+#include "Program.h"
 
 class Grammar;
 
@@ -20,9 +21,12 @@ public:
      * @brief Конструктор свёртки.
      * @param from Какую последовательность лексем сворачивает эта свёртка.
      * @param action Действие, которое производится при свёртке.
+     * @param compile Действие, которое производится при свёртке во время компиляции: генерирует инструкции программы.
      */
     Convolution(const std::vector<Lexeme::LexemeType> &from,
-                const std::function<void(std::vector<Lexeme> &, Grammar &)> &action) : from_(from), action_(action) {}
+                const std::function<void(std::vector<Lexeme> &, Grammar &)> &action,
+                const std::function<void(std::vector<Lexeme> &, Program &)> &compile)
+                : from_(from), action_(action), compile_(compile) {}
 
     /**
      * @brief Проверить, начинается ли сворачиваемая этой свёрткой последовательность лексем с переданной последовательности лексем.
@@ -57,7 +61,15 @@ public:
      * @param lexemes Набор лексем. Состояние синтаксического анализатора.
      * @param grammar Грамматика языка.
      */
-    void apply(std::vector<Lexeme> &lexemes, Grammar& grammar);
+    void apply(std::vector<Lexeme> &lexemes, Grammar& grammar) const;
+
+    /**
+     * @brief Применить свёртку во время компиляции.
+     * @details Вместо вычисления значений в программу добавляются инструкции, которые их вычислят.
+     * @param lexemes Набор лексем. Состояние синтаксического анализатора.
+     * @param program Компилируемая программа.
+     */
+    void compile(std::vector<Lexeme> &lexemes, Program &program) const;
 
     /**
      * @brief Печать информации о свёртке для отладки и сообщений об ошибках.
@@ -68,13 +80,22 @@ public:
      * @brief Сколько лексем сворачивает данная свёртка?
      * @return Количество сворачиваемых лексем.
      */
-    size_t size() {
+    size_t size() const {
         return from_.size();
     }
 
+    /**
+     * @brief Какую последовательность лексем сворачивает данная свёртка?
+     * @return Последовательность типов сворачиваемых лексем.
+     */
+    const std::vector<Lexeme::LexemeType> &get_from() const {
+        return from_;
+    }
+
 private:
     std::vector<Lexeme::LexemeType> from_;
     std::function<void(std::vector<Lexeme> &, Grammar& grammar)> action_;
+    std::function<void(std::vector<Lexeme> &, Program& program)> compile_;
 };
 
 
@@ -0,0 +1,37 @@
+#include "Environment.h"
+
+uint32_t Environment::resolve(const std::string &name) {
+    auto found = slot_indexes_.find(name);
+    if (found != slot_indexes_.end()) {
+        return found->second;
+    }
+    slots_.emplace_back(Lexeme::LexemeType::IDENTIFIER, name);
+    defined_.push_back(false);
+    auto slot = static_cast<uint32_t>(slots_.size() - 1);
+    slot_indexes_[name] = slot;
+    return slot;
+}
+
+std::optional<uint32_t> Environment::find_slot(const std::string &name) const {
+    auto found = slot_indexes_.find(name);
+    if (found == slot_indexes_.end()) {
+        return std::nullopt;
+    }
+    return found->second;
+}
+
+Lexeme &Environment::at(uint32_t slot) {
+    return slots_[slot];
+}
+
+const Lexeme &Environment::at(uint32_t slot) const {
+    return slots_[slot];
+}
+
+void Environment::define(uint32_t slot) {
+    defined_[slot] = true;
+}
+
+bool Environment::is_defined(uint32_t slot) const {
+    return defined_[slot];
+}
@@ -0,0 +1,63 @@
+#ifndef MADEALGORITHMSHOMEWORK2_ENVIRONMENT_H
+#define MADEALGORITHMSHOMEWORK2_ENVIRONMENT_H
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+
+#include "Lexeme.h"
+
+/**
+ * @brief Таблица переменных программы.
+ * @details Каждой переменной один раз выдаётся номер ячейки, после чего чтение и запись
+ * выполняются обращением к элементу непрерывного массива без поиска по имени.
+ */
+class Environment {
+public:
+    Environment() = default;
+
+    /**
+     * @brief Получить номер ячейки переменной. Если переменной ещё нет, для неё выделяется новая ячейка.
+     * @param name Имя переменной.
+     * @return Номер ячейки.
+     */
+    uint32_t resolve(const std::string &name);
+
+    /**
+     * @brief Найти номер ячейки переменной, не выделяя новую.
+     * @param name Имя переменной.
+     * @return Номер ячейки, если переменная уже встречалась.
+     */
+    std::optional<uint32_t> find_slot(const std::string &name) const;
+
+    /**
+     * @brief Получить переменную по номеру ячейки.
+     * @details Пока переменной не присвоено значение, ячейка содержит идентификатор без значения.
+     * @param slot Номер ячейки.
+     * @return Лексема переменной.
+     */
+    Lexeme &at(uint32_t slot);
+    const Lexeme &at(uint32_t slot) const;
+
+    /**
+     * @brief Отметить, что переменной в ячейке присвоено значение.
+     * @param slot Номер ячейки.
+     */
+    void define(uint32_t slot);
+
+    /**
+     * @brief Присвоено ли значение переменной в ячейке.
+     * @param slot Номер ячейки.
+     * @return True, если переменная определена, иначе - false.
+     */
+    bool is_defined(uint32_t slot) const;
+
+private:
+    std::vector<Lexeme> slots_;
+    std::vector<bool> defined_;
+    std::unordered_map<std::string, uint32_t> slot_indexes_;
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_ENVIRONMENT_H
@@ -7,50 +7,92 @@
 #include <cassert>
 #include <unordered_map>
 #include <iostream>
+#include <optional>
+#include <memory>
+#include <string_view>
 
 #include "Lexeme.h"
-#include "Convolution.h"
+#include "Environment.h"
+#include "Language.h"
 
 class Convolution;
+class Language;
 
 /**
- * @brief Класс, описывающий грамматику языка
+ * @brief Сеанс выполнения кода: общий неизменяемый язык (класс Language) и собственные переменные.
+ * @details Язык строится один раз и разделяется между сеансами, а переменные у каждого сеанса свои,
+ * поэтому разные сеансы можно выполнять в разных потоках одновременно.
  */
 class Grammar {
 public:
+    /**
+     * @brief Новый сеанс над общим для всей программы экземпляром языка.
+     */
     Grammar();
 
     /**
-     * @brief Добавляет лексему в язык.
-     * @param lexeme Лексема.
+     * @brief Новый сеанс над переданным языком.
+     * @param language Язык.
+     */
+    explicit Grammar(std::shared_ptr<const Language> language);
+
+    /**
+     * @brief Получить язык, над которым работает сеанс.
+     * @return Язык.
+     */
+    const Language &get_language() const;
+
+    /**
+     * @brief Присвоить значение переменной.
+     * @param lexeme Лексема переменной вместе с новым значением.
      */
-    void add_lexeme(const Lexeme& lexeme);
+    void set_variable(const Lexeme &lexeme);
+
+    // методы для получения таблицы переменных
+    Environment &get_environment();
+    const Environment &get_environment() const;
 
     /**
-     * @brief Найти лексему в языке.
+     * @brief Найти лексему в языке или переменную, которой уже присвоено значение.
      * @param code Строковое представление лексемы в коде.
      * @return Искомая лексема, если она присутствует в языке.
      */
     std::optional<Lexeme> find_lexeme(const std::string &code) const;
 
+    /**
+     * @brief Найти встроенную лексему языка (оператор, разделитель, константу или функцию) без копирования.
+     * @details Переменные, добавленные во время работы, здесь не ищутся.
+     * @param code Строковое представление лексемы в коде.
+     * @return Указатель на лексему или nullptr, если такой встроенной лексемы нет.
+     */
+    const Lexeme *find_keyword(std::string_view code) const;
+
     /**
      * @brief Требуется ли чтение следующей лексемы при синтаксическом анализе.
-     * @param current_sequence Состояние анализатора. Предыдущие прочитанные лексемы, возможно, подвергнутые свёрткам.
+     * @param state Состояние анализатора, соответствующее предыдущим прочитанным лексемам, возможно, подвергнутым свёрткам.
      * @param next Следующая лексема.
      * @return True, если нужно читать следующую лексему, иначе - false.
      */
-    bool need_next(const std::vector<Lexeme> &current_sequence, const Lexeme& next);
+    bool need_next(size_t state, const Lexeme &next) const;
+
+    /**
+     * @brief Состояние анализатора после чтения следующей лексемы.
+     * @param state Текущее состояние анализатора.
+     * @param next Прочитанная лексема.
+     * @return Новое состояние анализатора.
+     */
+    size_t next_state(size_t state, const Lexeme &next) const;
 
     /**
      * @brief Найти свёртку при синтаксическом анализе.
-     * @param current_sequence Состояние анализатора. Предыдущие прочитанные лексемы, возможно, подвергнутые свёрткам.
-     * @return Свёртка, которую нужно применить, если она имеется в языке.
+     * @param state Состояние анализатора, соответствующее предыдущим прочитанным лексемам, возможно, подвергнутым свёрткам.
+     * @return Свёртка, которую нужно применить, или nullptr, если такой нет в языке.
      */
-    const std::optional<Convolution> find_convolution(const std::vector<Lexeme> &current_sequence);
+    const Convolution *find_convolution(size_t state) const;
 
 private:
-    std::unordered_map<std::string, Lexeme> lexemes_;
-    std::vector<Convolution> convolutions_;
+    std::shared_ptr<const Language> language_;
+    Environment variables_;
 };
 
 #endif //MADEALGORITHMSHOMEWORK2_GRAMMAR_H
@@ -0,0 +1,48 @@
+#include "KeywordTable.h"
+
+KeywordTable::KeywordTable(const std::vector<Lexeme> &keywords) {
+    /*
+     * Перебираем затравку хеш-функции и размер таблицы, пока все лексемы не попадут в разные ячейки.
+     * Встроенных лексем несколько десятков, поэтому подходящая пара находится быстро,
+     * а таблица получается не больше чем в несколько раз длиннее набора лексем.
+     */
+    for (size_t size = keywords.size() * 2 + 1;; ++size) {
+        for (size_t seed = 0; seed < 64; ++seed) {
+            std::vector<std::optional<Lexeme>> table(size);
+            bool is_perfect = true;
+            for (const auto &keyword: keywords) {
+                auto &cell = table[hash(keyword.get_code(), seed) % size];
+                if (cell.has_value()) {
+                    is_perfect = false;
+                    break;
+                }
+                cell = keyword;
+            }
+            if (is_perfect) {
+                table_ = std::move(table);
+                seed_ = seed;
+                return;
+            }
+        }
+    }
+}
+
+const Lexeme *KeywordTable::find(std::string_view code) const {
+    if (table_.empty()) {
+        return nullptr;
+    }
+    const auto &cell = table_[hash(code, seed_) % table_.size()];
+    if (!cell.has_value() || (cell->get_code() != code)) {
+        return nullptr;
+    }
+    return &cell.value();
+}
+
+size_t KeywordTable::hash(std::string_view code, size_t seed) {
+    uint64_t result = 14695981039346656037ull ^ seed;
+    for (auto symbol: code) {
+        result ^= static_cast<uint8_t>(symbol);
+        result *= 1099511628211ull;
+    }
+    return static_cast<size_t>(result);
+}
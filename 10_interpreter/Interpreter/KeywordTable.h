@@ -0,0 +1,47 @@
+#ifndef MADEALGORITHMSHOMEWORK2_KEYWORDTABLE_H
+#define MADEALGORITHMSHOMEWORK2_KEYWORDTABLE_H
+
+#include <string_view>
+#include <vector>
+#include <optional>
+
+#include "Lexeme.h"
+
+/**
+ * @brief Таблица встроенных лексем языка (операторов, разделителей, констант и функций) с совершенной хеш-функцией.
+ * @details Набор встроенных лексем известен при создании грамматики, поэтому размер таблицы подбирается так,
+ * чтобы у разных лексем не было коллизий. Поиск - одно вычисление хеша и одно сравнение строк,
+ * без создания строк и копирования лексем.
+ */
+class KeywordTable {
+public:
+    KeywordTable() = default;
+
+    /**
+     * @brief Построить таблицу.
+     * @param keywords Встроенные лексемы. Символьные представления должны быть различны.
+     */
+    explicit KeywordTable(const std::vector<Lexeme> &keywords);
+
+    /**
+     * @brief Найти встроенную лексему.
+     * @param code Символьное представление лексемы в коде.
+     * @return Указатель на лексему или nullptr, если такой встроенной лексемы нет.
+     */
+    const Lexeme *find(std::string_view code) const;
+
+private:
+    std::vector<std::optional<Lexeme>> table_;
+    size_t seed_{0};
+
+    /**
+     * @brief Хеш-функция FNV-1a с затравкой.
+     * @param code Строка.
+     * @param seed Затравка.
+     * @return Значение хеша.
+     */
+    static size_t hash(std::string_view code, size_t seed);
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_KEYWORDTABLE_H
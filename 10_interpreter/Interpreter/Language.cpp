@@ -0,0 +1,755 @@
+#include <cmath>
+#include <functional>
+#include <type_traits>
+
+#include "Language.h"
+#include "Grammar.h"
+#include "Convolution.h"
+
+/**
+ * @brief Прочитать число нужного типа из скалярного значения.
+ */
+template<typename Type>
+static Type scalar_value(const Lexeme::Scalar &scalar) {
+    if constexpr (std::is_same_v<Type, int64_t>) {
+        return scalar.integer;
+    } else {
+        return scalar.floating;
+    }
+}
+
+/**
+ * @brief Участвует ли в бинарной операции массив.
+ */
+static bool is_array_operation(const Lexeme &lhs, const Lexeme &rhs) {
+    return (lhs.get_type_value() == Lexeme::ValueType::ARR) || (rhs.get_type_value() == Lexeme::ValueType::ARR);
+}
+
+/**
+ * @brief Тип элементов операнда поэлементной операции: для массива - тип его элементов, для числа - тип числа.
+ */
+static Lexeme::ValueType element_type(const Lexeme &operand) {
+    if (operand.get_type_value() == Lexeme::ValueType::ARR) {
+        return operand.get_type_subvalue();
+    }
+    return operand.get_type_value();
+}
+
+/**
+ * @brief Цикл поэлементной операции над непрерывными буферами.
+ * @details Для каждого сочетания "массив-массив", "массив-число", "число-массив" свой цикл без ветвлений,
+ * чтобы компилятор мог его векторизовать.
+ */
+template<typename Type, typename Operation>
+static void elementwise_loop(const Lexeme &lhs, const Lexeme &rhs, Operation operation,
+                             std::vector<Lexeme::Scalar> &result) {
+    const auto size = result.size();
+    if ((lhs.get_type_value() == Lexeme::ValueType::ARR) && (rhs.get_type_value() == Lexeme::ValueType::ARR)) {
+        const auto *left = lhs.get_array().data();
+        const auto *right = rhs.get_array().data();
+        for (size_t i = 0; i < size; ++i) {
+            result[i] = operation(scalar_value<Type>(left[i]), scalar_value<Type>(right[i]));
+        }
+    } else if (lhs.get_type_value() == Lexeme::ValueType::ARR) {
+        const auto *left = lhs.get_array().data();
+        const auto right = scalar_value<Type>(rhs.get_scalar());
+        for (size_t i = 0; i < size; ++i) {
+            result[i] = operation(scalar_value<Type>(left[i]), right);
+        }
+    } else {
+        const auto left = scalar_value<Type>(lhs.get_scalar());
+        const auto *right = rhs.get_array().data();
+        for (size_t i = 0; i < size; ++i) {
+            result[i] = operation(left, scalar_value<Type>(right[i]));
+        }
+    }
+}
+
+/**
+ * @brief Поэлементная операция над числовыми массивами одинаковой длины или над массивом и числом.
+ * @param lhs Первый операнд.
+ * @param rhs Второй операнд.
+ * @param operation Операция над двумя числами. Если она возвращает bool, результат - логический массив.
+ * @param result_type Тип лексемы-результата.
+ * @return Массив результатов или lhs, если операция недопустима.
+ */
+template<typename Operation>
+static Lexeme elementwise(const Lexeme &lhs, const Lexeme &rhs, Operation operation, Lexeme::LexemeType result_type) {
+    auto type = element_type(lhs);
+    if (type != element_type(rhs)) {
+        std::cerr << "Operands must be of the same type." << std::endl;
+        return lhs;
+    }
+    if ((type != Lexeme::ValueType::INTEGER) && (type != Lexeme::ValueType::FLOAT)) {
+        std::cerr << "Operands must be of number type." << std::endl;
+        return lhs;
+    }
+    auto size = std::max(lhs.get_size(), rhs.get_size());
+    if (is_array_operation(lhs, rhs) && (lhs.get_type_value() == rhs.get_type_value()) &&
+        (lhs.get_size() != rhs.get_size())) {
+        std::cerr << "Arrays must be of the same length." << std::endl;
+        return lhs;
+    }
+    std::vector<Lexeme::Scalar> elements(size);
+    if (type == Lexeme::ValueType::INTEGER) {
+        elementwise_loop<int64_t>(lhs, rhs, operation, elements);
+    } else {
+        elementwise_loop<double>(lhs, rhs, operation, elements);
+    }
+    using ResultValue = decltype(operation(int64_t{}, int64_t{}));
+    auto result_subtype = std::is_same_v<ResultValue, bool> ? Lexeme::ValueType::BOOL : type;
+    Lexeme result(result_type, "", Lexeme::ValueType::NONE, Lexeme::Scalar());
+    result.set_array(result_subtype, std::move(elements));
+    return result;
+}
+
+/**
+ * @brief Свернуть числовой массив в одно число.
+ * @param array Массив.
+ * @param operation Операция над накопленным значением и очередным элементом.
+ * @return Результат или array, если операция недопустима.
+ */
+template<typename Operation>
+static Lexeme reduce(const Lexeme &array, Operation operation) {
+    if (array.get_type_value() != Lexeme::ValueType::ARR) {
+        std::cerr << "Operand must be of array type." << std::endl;
+        return array;
+    }
+    const auto &elements = array.get_array();
+    Lexeme result(Lexeme::LexemeType::FACTOR, "", array.get_type_subvalue(), elements.front());
+    switch (array.get_type_subvalue()) {
+        case Lexeme::ValueType::INTEGER: {
+            auto value = elements.front().integer;
+            for (size_t i = 1; i < elements.size(); ++i) {
+                value = operation(value, elements[i].integer);
+            }
+            result.set_integer(value);
+            break;
+        }
+        case Lexeme::ValueType::FLOAT: {
+            auto value = elements.front().floating;
+            for (size_t i = 1; i < elements.size(); ++i) {
+                value = operation(value, elements[i].floating);
+            }
+            result.set_float(value);
+            break;
+        }
+        default:
+            std::cerr << "Operands must be of number type." << std::endl;
+            return array;
+    }
+    return result;
+}
+
+/**
+ * @brief Бинарная операция над числами: арифметика или сравнение.
+ * @details Типы операндов проверяются один раз, после чего значение вычисляется сразу нужного типа
+ * без копирования лексемы-операнда. Если участвует массив, операция выполняется поэлементно.
+ * @param lhs Первый операнд.
+ * @param rhs Второй операнд.
+ * @param operation Операция над двумя числами. Если она возвращает bool, результат - логическое значение.
+ * @param result_type Тип лексемы-результата.
+ * @param code Символьное представление лексемы-результата.
+ * @return Результат или lhs, если операция недопустима.
+ */
+template<typename Operation>
+static Lexeme numeric(const Lexeme &lhs, const Lexeme &rhs, Operation operation, Lexeme::LexemeType result_type,
+                      const std::string &code) {
+    if (is_array_operation(lhs, rhs)) {
+        return elementwise(lhs, rhs, operation, result_type);
+    }
+    const auto type = lhs.get_type_value();
+    if (type != rhs.get_type_value()) {
+        std::cerr << "Operands must be of the same type." << std::endl;
+        return lhs;
+    }
+    using ResultValue = decltype(operation(int64_t{}, int64_t{}));
+    constexpr bool is_comparison = std::is_same_v<ResultValue, bool>;
+    switch (type) {
+        case Lexeme::ValueType::INTEGER: {
+            auto value = operation(lhs.get_integer(), rhs.get_integer());
+            return Lexeme(result_type, code, is_comparison ? Lexeme::ValueType::BOOL : type, value);
+        }
+        case Lexeme::ValueType::FLOAT: {
+            auto value = operation(lhs.get_float(), rhs.get_float());
+            return Lexeme(result_type, code, is_comparison ? Lexeme::ValueType::BOOL : type, value);
+        }
+        default:
+            std::cerr << "Operands must be of number type." << std::endl;
+            return lhs;
+    }
+}
+
+/**
+ * @brief Здесь описана вся грамматика языка и даже чуть больше.
+ */
+Language::Language() {
+    // добавляем в язык лексемы
+
+    // Константы и стандартные функции
+    add_lexeme(Lexeme(Lexeme::LexemeType::CONSTANT, "PI", Lexeme::ValueType::FLOAT, 3.1415926));
+    add_lexeme(Lexeme(Lexeme::LexemeType::CONSTANT, "PHI", Lexeme::ValueType::FLOAT, 1.618));
+    add_lexeme(Lexeme(Lexeme::LexemeType::CONSTANT, "true", Lexeme::ValueType::BOOL, true));
+    add_lexeme(Lexeme(Lexeme::LexemeType::CONSTANT, "false", Lexeme::ValueType::BOOL, false));
+
+    static const Lexeme false_lexeme = lexemes_["false"];
+    static const Lexeme true_lexeme = lexemes_["true"];
+
+    add_lexeme(Lexeme(Lexeme::LexemeType::IDENTIFIER, "sqrt", [](Lexeme &lhs, Lexeme &rhs) {
+        Lexeme result = lhs;
+        switch (result.get_type_value()) {
+            case Lexeme::ValueType::FLOAT: {
+                result.set_float(std::sqrt(lhs.get_float()));
+                break;
+            }
+            default:
+                std::cerr << "Operands must be of float type." << std::endl;
+                return lhs;
+        }
+        result.set_type(Lexeme::LexemeType::FACTOR);
+        return result;
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::IDENTIFIER, "square", [](Lexeme &lhs, Lexeme &rhs) {
+        Lexeme result = lhs;
+        switch (result.get_type_value()) {
+            case Lexeme::ValueType::INTEGER: {
+                result.set_integer(lhs.get_integer() * lhs.get_integer());
+                break;
+            }
+            case Lexeme::ValueType::FLOAT: {
+                result.set_float(lhs.get_float() * lhs.get_float());
+                break;
+            }
+            default:
+                std::cerr << "Operands must be of float type." << std::endl;
+                return lhs;
+        }
+        result.set_type(Lexeme::LexemeType::FACTOR);
+        return result;
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::IDENTIFIER, "print", [](Lexeme &lhs, Lexeme &rhs) {
+        lhs.print();
+        return Lexeme();
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::IDENTIFIER, "len", [](Lexeme &lhs, Lexeme &rhs) {
+        switch (lhs.get_type_value()) {
+            case Lexeme::ValueType::ARR:
+                break;
+            default:
+                std::cerr << "Operand must be of array type." << std::endl;
+                return lhs;
+        }
+        auto length = static_cast<int64_t>(lhs.get_size());
+        return Lexeme(Lexeme::LexemeType::FACTOR, "", Lexeme::ValueType::INTEGER, length);
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::IDENTIFIER, "sum", [](Lexeme &lhs, Lexeme &rhs) {
+        return reduce(lhs, std::plus<>());
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::IDENTIFIER, "min", [](Lexeme &lhs, Lexeme &rhs) {
+        return reduce(lhs, [](auto lhs_value, auto rhs_value) { return std::min(lhs_value, rhs_value); });
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::IDENTIFIER, "max", [](Lexeme &lhs, Lexeme &rhs) {
+        return reduce(lhs, [](auto lhs_value, auto rhs_value) { return std::max(lhs_value, rhs_value); });
+    }));
+
+
+    // лексемы-разделители
+    add_lexeme(Lexeme(Lexeme::LexemeType::LEFT_CIRCLE_BRACKET, "("));
+    add_lexeme(Lexeme(Lexeme::LexemeType::RIGHT_CIRCLE_BRACKET, ")"));
+    add_lexeme(Lexeme(Lexeme::LexemeType::LEFT_SQUARE_BRACKET, "["));
+    add_lexeme(Lexeme(Lexeme::LexemeType::RIGHT_SQUARE_BRACKET, "]"));
+    add_lexeme(Lexeme(Lexeme::LexemeType::END, ";"));
+    add_lexeme(Lexeme(Lexeme::LexemeType::COMMA, ","));
+
+
+    // присваивание
+    add_lexeme(Lexeme(Lexeme::LexemeType::ASSIGN, "=", [](Lexeme &lhs, Lexeme &rhs) {
+        lhs.set_value(rhs);
+        lhs.print();
+        return Lexeme();
+    }));
+
+
+    // арифметические операции
+    add_lexeme(Lexeme(Lexeme::LexemeType::PLUS, "+", [](Lexeme &lhs, Lexeme &rhs) {
+        return numeric(lhs, rhs, std::plus<>(), Lexeme::LexemeType::EXPRESSION, lhs.get_code());
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::MINUS, "-", [](Lexeme &lhs, Lexeme &rhs) {
+        return numeric(lhs, rhs, std::minus<>(), Lexeme::LexemeType::EXPRESSION, lhs.get_code());
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::DIVISION, "/", [](Lexeme &lhs, Lexeme &rhs) {
+        return numeric(lhs, rhs, std::divides<>(), Lexeme::LexemeType::TERM, lhs.get_code());
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::MULTIPLICATION, "*", [](Lexeme &lhs, Lexeme &rhs) {
+        return numeric(lhs, rhs, std::multiplies<>(), Lexeme::LexemeType::TERM, lhs.get_code());
+    }));
+
+
+    // логические операции
+    add_lexeme(Lexeme(Lexeme::LexemeType::LOGICAL_AND, "&&", [](Lexeme &lhs, Lexeme &rhs) {
+        if (lhs.get_type_value() != rhs.get_type_value()) {
+            std::cerr << "Operands must be of the same type." << std::endl;
+            return lhs;
+        }
+        Lexeme result = lhs;
+        switch (result.get_type_value()) {
+            case Lexeme::ValueType::BOOL: {
+                result.set_bool(lhs.get_bool() && rhs.get_bool());
+                break;
+            }
+            default:
+                std::cerr << "Operands must be of boolean type." << std::endl;
+                return lhs;
+        }
+        result.set_type(Lexeme::LexemeType::EXPRESSION);
+        return result;
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::LOGICAL_OR, "||", [](Lexeme &lhs, Lexeme &rhs) {
+        if (lhs.get_type_value() != rhs.get_type_value()) {
+            std::cerr << "Operands must be of the same type." << std::endl;
+            return lhs;
+        }
+        Lexeme result = lhs;
+        switch (result.get_type_value()) {
+            case Lexeme::ValueType::BOOL: {
+                result.set_bool(lhs.get_bool() || rhs.get_bool());
+                break;
+            }
+            default:
+                std::cerr << "Operands must be of boolean type." << std::endl;
+                return lhs;
+        }
+        result.set_type(Lexeme::LexemeType::EXPRESSION);
+        return result;
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::LOGICAL_XOR, "^", [](Lexeme &lhs, Lexeme &rhs) {
+        if (lhs.get_type_value() != rhs.get_type_value()) {
+            std::cerr << "Operands must be of the same type." << std::endl;
+            return lhs;
+        }
+        Lexeme result = lhs;
+        switch (result.get_type_value()) {
+            case Lexeme::ValueType::BOOL: {
+                result.set_bool(lhs.get_bool() != rhs.get_bool());
+                break;
+            }
+            default:
+                std::cerr << "Operands must be of boolean type." << std::endl;
+                return lhs;
+        }
+        result.set_type(Lexeme::LexemeType::EXPRESSION);
+        return result;
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::LOGICAL_NOT, "!", [](Lexeme &lhs, Lexeme &rhs) {
+        if (lhs.get_type_value() != Lexeme::ValueType::BOOL) {
+            std::cerr << "Operand must be of boolean type." << std::endl;
+            return lhs;
+        }
+        Lexeme result = lhs;
+        result.set_bool(!lhs.get_bool());
+        result.set_type(Lexeme::LexemeType::TERM);
+        return result;
+    }));
+
+
+    // операции сравнения
+    add_lexeme(Lexeme(Lexeme::LexemeType::EQUAL, "==", [&true_lexeme](Lexeme &lhs, Lexeme &rhs) {
+        if (lhs.get_type_value() != rhs.get_type_value()) {
+            std::cerr << "Operands must be of the same type." << std::endl;
+            return lhs;
+        }
+        Lexeme result = true_lexeme;
+        result.set_bool(lhs.value_equals(rhs));
+        result.set_type(Lexeme::LexemeType::EXPRESSION);
+        return result;
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::NOT_EQUAL, "!=", [&true_lexeme](Lexeme &lhs, Lexeme &rhs) {
+        if (lhs.get_type_value() != rhs.get_type_value()) {
+            std::cerr << "Operands must be of the same type." << std::endl;
+            return lhs;
+        }
+        Lexeme result = true_lexeme;
+        result.set_bool(!lhs.value_equals(rhs));
+        result.set_type(Lexeme::LexemeType::EXPRESSION);
+        return result;
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::LESS, "<", [&true_lexeme](Lexeme &lhs, Lexeme &rhs) {
+        return numeric(lhs, rhs, std::less<>(), Lexeme::LexemeType::EXPRESSION, true_lexeme.get_code());
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::GREATER, ">", [&true_lexeme](Lexeme &lhs, Lexeme &rhs) {
+        return numeric(lhs, rhs, std::greater<>(), Lexeme::LexemeType::EXPRESSION, true_lexeme.get_code());
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::GREATER_OR_EQUAL, ">=", [&true_lexeme](Lexeme &lhs, Lexeme &rhs) {
+        return numeric(lhs, rhs, std::greater_equal<>(), Lexeme::LexemeType::EXPRESSION, true_lexeme.get_code());
+    }));
+    add_lexeme(Lexeme(Lexeme::LexemeType::LESS_OR_EQUAL, "<=", [&true_lexeme](Lexeme &lhs, Lexeme &rhs) {
+        return numeric(lhs, rhs, std::less_equal<>(), Lexeme::LexemeType::EXPRESSION, true_lexeme.get_code());
+    }));
+
+
+    // добавляем в язык свёртки
+
+    // действия свёрток во время компиляции, общие для многих свёрток
+    auto compile_retype = [](Lexeme::LexemeType result_type) {
+        return [result_type](std::vector<Lexeme> &lexemes, Program &) {
+            lexemes.back().set_type(result_type);
+        };
+    };
+    auto compile_binary = [](Lexeme::LexemeType result_type) {
+        return [result_type](std::vector<Lexeme> &lexemes, Program &program) {
+            program.emit(Program::OpCode::BINARY, 0, program.add_action(*(lexemes.end() - 2)));
+            lexemes.erase(lexemes.end() - 3, lexemes.end());
+            lexemes.emplace_back(result_type, "");
+        };
+    };
+
+    // общего назначения
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::IDENTIFIER},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                lexemes.back().set_type(Lexeme::LexemeType::FACTOR);
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::LOAD, program.add_name(lexemes.back().get_code()));
+                lexemes.back().set_type(Lexeme::LexemeType::FACTOR);
+            }));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::CONSTANT},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                lexemes.back().set_type(Lexeme::LexemeType::FACTOR);
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::PUSH, program.add_lexeme(lexemes.back()));
+                lexemes.back().set_type(Lexeme::LexemeType::FACTOR);
+            }));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::FACTOR},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                lexemes.back().set_type(Lexeme::LexemeType::TERM);
+            },
+            compile_retype(Lexeme::LexemeType::TERM)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::TERM},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                lexemes.back().set_type(Lexeme::LexemeType::EXPRESSION);
+            },
+            compile_retype(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::STATEMENT, Lexeme::LexemeType::END},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                lexemes.erase(lexemes.end() - 2, lexemes.end());
+            },
+            [](std::vector<Lexeme> &lexemes, Program &) {
+                lexemes.erase(lexemes.end() - 2, lexemes.end());
+            }));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::IDENTIFIER, Lexeme::LexemeType::ASSIGN, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                grammar.set_variable(*(lexemes.end() - 3));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::STATEMENT, "");
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::STORE,
+                             program.add_name((lexemes.end() - 3)->get_code()),
+                             program.add_action(*(lexemes.end() - 2)));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::STATEMENT, "");
+            }));
+
+
+    // арифметические операции
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::TERM, Lexeme::LexemeType::PLUS, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::TERM, Lexeme::LexemeType::MINUS, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::TERM, Lexeme::LexemeType::MULTIPLICATION, Lexeme::LexemeType::FACTOR},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::TERM)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::TERM, Lexeme::LexemeType::DIVISION, Lexeme::LexemeType::FACTOR},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::TERM)));
+
+
+    // приоритет операций
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::LEFT_CIRCLE_BRACKET, Lexeme::LexemeType::EXPRESSION,
+             Lexeme::LexemeType::RIGHT_CIRCLE_BRACKET},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = *(lexemes.end() - 2);
+                result.set_type(Lexeme::LexemeType::FACTOR);
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            [](std::vector<Lexeme> &lexemes, Program &) {
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::FACTOR, "");
+            }));
+
+
+    // логические операции
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::TERM, Lexeme::LexemeType::LOGICAL_AND, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::TERM, Lexeme::LexemeType::LOGICAL_OR, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::TERM, Lexeme::LexemeType::LOGICAL_XOR, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::LOGICAL_NOT, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto dummy = Lexeme();
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 1), dummy);
+                lexemes.erase(lexemes.end() - 2, lexemes.end());
+                lexemes.push_back(result);
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::UNARY, 0, program.add_action(*(lexemes.end() - 2)));
+                lexemes.erase(lexemes.end() - 2, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::TERM, "");
+            }));
+
+
+    // операции сравнения
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::EXPRESSION, Lexeme::LexemeType::EQUAL, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::EXPRESSION, Lexeme::LexemeType::NOT_EQUAL, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::EXPRESSION, Lexeme::LexemeType::LESS, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::EXPRESSION, Lexeme::LexemeType::GREATER, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::EXPRESSION, Lexeme::LexemeType::LESS_OR_EQUAL, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::EXPRESSION, Lexeme::LexemeType::GREATER_OR_EQUAL, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 2)->exec_action(*(lexemes.end() - 3), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 3, lexemes.end());
+                lexemes.push_back(result);
+            },
+            compile_binary(Lexeme::LexemeType::EXPRESSION)));
+
+
+    //вызов функций одного переменного
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::IDENTIFIER, Lexeme::LexemeType::LEFT_CIRCLE_BRACKET, Lexeme::LexemeType::EXPRESSION,
+             Lexeme::LexemeType::RIGHT_CIRCLE_BRACKET},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto dummy = Lexeme();
+                auto result = (lexemes.end() - 4)->exec_action(*(lexemes.end() - 2), dummy);
+                lexemes.erase(lexemes.end() - 4, lexemes.end());
+                lexemes.push_back(result);
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::UNARY, 0, program.add_action(*(lexemes.end() - 4)));
+                lexemes.erase(lexemes.end() - 4, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::FACTOR, "");
+            }));
+
+
+    // массивы
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                lexemes.back().set_type(Lexeme::LexemeType::LIST);
+                lexemes.back().wrap_into_array();
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::MAKE_LIST);
+                lexemes.back().set_type(Lexeme::LexemeType::LIST);
+            }));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::LIST, Lexeme::LexemeType::END},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                lexemes.erase(lexemes.end() - 2, lexemes.end());
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                // значение выражения, которое не присваивается переменной, не нужно
+                program.emit(Program::OpCode::POP);
+                lexemes.erase(lexemes.end() - 2, lexemes.end());
+            }));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::LIST, Lexeme::LexemeType::COMMA, Lexeme::LexemeType::EXPRESSION},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                (lexemes.end() - 3)->push_back_element(*(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 2, lexemes.end());
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::APPEND_LIST);
+                lexemes.erase(lexemes.end() - 2, lexemes.end());
+            }));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::IDENTIFIER, Lexeme::LexemeType::ASSIGN, Lexeme::LexemeType::LEFT_SQUARE_BRACKET,
+             Lexeme::LexemeType::LIST, Lexeme::LexemeType::RIGHT_SQUARE_BRACKET},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                (lexemes.end() - 4)->exec_action(*(lexemes.end() - 5), *(lexemes.end() - 2));
+                grammar.set_variable(*(lexemes.end() - 5));
+                lexemes.erase(lexemes.end() - 5, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::STATEMENT, "");
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::STORE,
+                             program.add_name((lexemes.end() - 5)->get_code()),
+                             program.add_action(*(lexemes.end() - 4)));
+                lexemes.erase(lexemes.end() - 5, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::STATEMENT, "");
+            }));
+    convolutions_.push_back(Convolution(
+            {Lexeme::LexemeType::IDENTIFIER, Lexeme::LexemeType::LEFT_SQUARE_BRACKET, Lexeme::LexemeType::EXPRESSION,
+             Lexeme::LexemeType::RIGHT_SQUARE_BRACKET},
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                auto result = (lexemes.end() - 4)->get_element(*(lexemes.end() - 2));
+                lexemes.erase(lexemes.end() - 4, lexemes.end());
+                if (result.has_value()) {
+                    lexemes.push_back(result.value());
+                }
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::LOAD_ELEMENT, program.add_name((lexemes.end() - 4)->get_code()));
+                lexemes.erase(lexemes.end() - 4, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::FACTOR, "");
+            }));
+    convolutions_.push_back(Convolution(
+            {
+                    Lexeme::LexemeType::IDENTIFIER,
+                    Lexeme::LexemeType::LEFT_SQUARE_BRACKET,
+                    Lexeme::LexemeType::EXPRESSION,
+                    Lexeme::LexemeType::RIGHT_SQUARE_BRACKET,
+                    Lexeme::LexemeType::ASSIGN,
+                    Lexeme::LexemeType::EXPRESSION,
+            },
+            [](std::vector<Lexeme> &lexemes, Grammar &grammar) {
+                Lexeme result = *(lexemes.end() - 6);
+                bool is_set = result.set_element(*(lexemes.end() - 4), *(lexemes.end() - 1));
+                lexemes.erase(lexemes.end() - 6, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::STATEMENT, "");
+                if (is_set) {
+                    grammar.set_variable(result);
+                    result.print();
+                }
+            },
+            [](std::vector<Lexeme> &lexemes, Program &program) {
+                program.emit(Program::OpCode::STORE_ELEMENT, program.add_name((lexemes.end() - 6)->get_code()));
+                lexemes.erase(lexemes.end() - 6, lexemes.end());
+                lexemes.emplace_back(Lexeme::LexemeType::STATEMENT, "");
+            }));
+
+
+    // по готовому набору свёрток строим таблицу переходов синтаксического анализатора
+    parse_table_ = ParseTable(convolutions_);
+
+    // все лексемы, добавленные до этого момента, встроены в язык
+    std::vector<Lexeme> keywords;
+    for (const auto &[code, lexeme]: lexemes_) {
+        keywords.push_back(lexeme);
+    }
+    keywords_ = KeywordTable(keywords);
+}
+
+const std::shared_ptr<const Language> &Language::get_shared() {
+    static const std::shared_ptr<const Language> language = std::make_shared<const Language>();
+    return language;
+}
+
+void Language::add_lexeme(const Lexeme &lexeme) {
+    lexemes_[lexeme.get_code()] = lexeme;
+}
+
+const Lexeme *Language::find_builtin(const std::string &code) const {
+    auto found = lexemes_.find(code);
+    if (found == lexemes_.end()) {
+        return nullptr;
+    }
+    return &found->second;
+}
+
+const Lexeme *Language::find_keyword(std::string_view code) const {
+    return keywords_.find(code);
+}
+
+bool Language::need_next(size_t state, const Lexeme &next) const {
+    return parse_table_.need_next(state, next.get_type());
+}
+
+size_t Language::next_state(size_t state, const Lexeme &next) const {
+    return parse_table_.next_state(state, next.get_type());
+}
+
+const Convolution *Language::find_convolution(size_t state) const {
+    auto found = parse_table_.find_convolution(state);
+    if (!found.has_value()) {
+        return nullptr;
+    }
+    return &convolutions_[found.value()];
+}
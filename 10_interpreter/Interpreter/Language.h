@@ -0,0 +1,81 @@
+#ifndef MADEALGORITHMSHOMEWORK2_LANGUAGE_H
+#define MADEALGORITHMSHOMEWORK2_LANGUAGE_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Lexeme.h"
+#include "Convolution.h"
+#include "ParseTable.h"
+#include "KeywordTable.h"
+
+/**
+ * @brief Неизменяемое описание языка: встроенные лексемы (операторы, константы, функции), свёртки и таблицы анализатора.
+ * @details После построения не меняется, поэтому один экземпляр можно использовать одновременно из нескольких потоков.
+ * Переменные хранятся отдельно, в сеансе выполнения (класс Grammar).
+ */
+class Language {
+public:
+    Language();
+
+    /**
+     * @brief Общий для всей программы экземпляр языка. Строится при первом обращении.
+     * @return Указатель на язык.
+     */
+    static const std::shared_ptr<const Language> &get_shared();
+
+    /**
+     * @brief Найти встроенную лексему языка по её строковому представлению.
+     * @param code Строковое представление лексемы в коде.
+     * @return Указатель на лексему или nullptr, если такой встроенной лексемы нет.
+     */
+    const Lexeme *find_builtin(const std::string &code) const;
+
+    /**
+     * @brief Найти встроенную лексему языка через идеальный хеш без копирования строки.
+     * @param code Строковое представление лексемы в коде.
+     * @return Указатель на лексему или nullptr, если такой встроенной лексемы нет.
+     */
+    const Lexeme *find_keyword(std::string_view code) const;
+
+    /**
+     * @brief Требуется ли чтение следующей лексемы при синтаксическом анализе.
+     * @param state Состояние анализатора.
+     * @param next Следующая лексема.
+     * @return True, если нужно читать следующую лексему, иначе - false.
+     */
+    bool need_next(size_t state, const Lexeme &next) const;
+
+    /**
+     * @brief Состояние анализатора после чтения следующей лексемы.
+     * @param state Текущее состояние анализатора.
+     * @param next Прочитанная лексема.
+     * @return Новое состояние анализатора.
+     */
+    size_t next_state(size_t state, const Lexeme &next) const;
+
+    /**
+     * @brief Найти свёртку при синтаксическом анализе.
+     * @param state Состояние анализатора.
+     * @return Свёртка, которую нужно применить, или nullptr, если такой нет в языке.
+     */
+    const Convolution *find_convolution(size_t state) const;
+
+private:
+    std::unordered_map<std::string, Lexeme> lexemes_;
+    std::vector<Convolution> convolutions_;
+    ParseTable parse_table_;
+    KeywordTable keywords_;
+
+    /**
+     * @brief Добавляет встроенную лексему в язык. Используется только при построении языка.
+     * @param lexeme Лексема.
+     */
+    void add_lexeme(const Lexeme& lexeme);
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_LANGUAGE_H
@@ -6,11 +6,11 @@
 #include <cmath>
 #include "Lexeme.h"
 
-const std::__cxx11::string &Lexeme::get_code() const {
+const std::string &Lexeme::get_code() const {
     return code_;
 }
 
-void Lexeme::set_code(const std::__cxx11::string &code) {
+void Lexeme::set_code(const std::string &code) {
     Lexeme::code_ = code;
 }
 
@@ -38,15 +38,167 @@ void Lexeme::set_type_subvalue(Lexeme::ValueType type_subvalue) {
     Lexeme::type_subvalue_ = type_subvalue;
 }
 
-const std::vector<uint8_t> &Lexeme::get_data() const {
-    return data_;
+int64_t Lexeme::get_integer() const {
+    return scalar_.integer;
 }
 
-void Lexeme::set_data(const std::vector<uint8_t> &data) {
-    Lexeme::data_ = data;
+double Lexeme::get_float() const {
+    return scalar_.floating;
 }
 
-std::__cxx11::string Lexeme::LexemeTypeToString(Lexeme::LexemeType type) {
+bool Lexeme::get_bool() const {
+    return scalar_.boolean;
+}
+
+Lexeme::Scalar Lexeme::get_scalar() const {
+    return scalar_;
+}
+
+void Lexeme::set_integer(int64_t value) {
+    type_value_ = INTEGER;
+    scalar_.integer = value;
+}
+
+void Lexeme::set_float(double value) {
+    type_value_ = FLOAT;
+    scalar_.floating = value;
+}
+
+void Lexeme::set_bool(bool value) {
+    type_value_ = BOOL;
+    scalar_.boolean = value;
+}
+
+void Lexeme::set_value(const Lexeme &other) {
+    type_value_ = other.type_value_;
+    type_subvalue_ = other.type_subvalue_;
+    scalar_ = other.scalar_;
+    array_ = other.array_;
+}
+
+/**
+ * @brief Сравнить два скалярных значения.
+ * @param type Тип значений.
+ * @param lhs Первое значение.
+ * @param rhs Второе значение.
+ * @return True, если значения равны.
+ */
+static bool scalar_equals(Lexeme::ValueType type, Lexeme::Scalar lhs, Lexeme::Scalar rhs) {
+    switch (type) {
+        case Lexeme::ValueType::FLOAT:
+            return lhs.floating == rhs.floating;
+        case Lexeme::ValueType::BOOL:
+            return lhs.boolean == rhs.boolean;
+        case Lexeme::ValueType::NONE:
+            return true;
+        default:
+            return lhs.integer == rhs.integer;
+    }
+}
+
+bool Lexeme::value_equals(const Lexeme &other) const {
+    if (type_value_ != other.type_value_) {
+        return false;
+    }
+    if (type_value_ != ARR) {
+        return scalar_equals(type_value_, scalar_, other.scalar_);
+    }
+    if ((type_subvalue_ != other.type_subvalue_) || (get_size() != other.get_size())) {
+        return false;
+    }
+    for (size_t i = 0; i < get_size(); ++i) {
+        if (!scalar_equals(type_subvalue_, (*array_)[i], (*other.array_)[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::vector<Lexeme::Scalar> &Lexeme::get_array() const {
+    static const std::vector<Scalar> empty;
+    if ((type_value_ != ARR) || !array_) {
+        return empty;
+    }
+    return *array_;
+}
+
+void Lexeme::set_array(ValueType type_subvalue, std::vector<Scalar> elements) {
+    type_value_ = ARR;
+    type_subvalue_ = type_subvalue;
+    array_ = std::make_shared<std::vector<Scalar>>(std::move(elements));
+}
+
+size_t Lexeme::get_size() const {
+    if ((type_value_ != ARR) || !array_) {
+        return 0;
+    }
+    return array_->size();
+}
+
+void Lexeme::detach_array() {
+    if (array_.use_count() > 1) {
+        array_ = std::make_shared<std::vector<Scalar>>(*array_);
+    }
+}
+
+void Lexeme::wrap_into_array() {
+    type_subvalue_ = type_value_;
+    type_value_ = ARR;
+    array_ = std::make_shared<std::vector<Scalar>>(1, scalar_);
+}
+
+bool Lexeme::push_back_element(const Lexeme &element) {
+    if (type_subvalue_ != element.type_value_) {
+        std::cerr << "Operands must be of the same type." << std::endl;
+        return false;
+    }
+    detach_array();
+    array_->push_back(element.scalar_);
+    return true;
+}
+
+std::optional<size_t> Lexeme::check_index(const Lexeme &index) const {
+    if (index.get_type_value() != INTEGER) {
+        std::cerr << "Index must be of the integer type." << std::endl;
+        return std::nullopt;
+    }
+    if (type_value_ != ARR) {
+        std::cerr << "Operand must be of array type." << std::endl;
+        return std::nullopt;
+    }
+    if ((index.get_integer() < 0) || (static_cast<size_t>(index.get_integer()) >= get_size())) {
+        std::cerr << "Index out of range." << std::endl;
+        return std::nullopt;
+    }
+    return static_cast<size_t>(index.get_integer());
+}
+
+std::optional<Lexeme> Lexeme::get_element(const Lexeme &index) const {
+    auto position = check_index(index);
+    if (!position.has_value()) {
+        return std::nullopt;
+    }
+    std::string result_code = code_ + "[" + std::to_string(position.value()) + "]";
+    // элементы неизвестного типа читаем как целые числа
+    auto result_type = (type_subvalue_ == NONE) ? INTEGER : type_subvalue_;
+    return Lexeme(FACTOR, result_code, result_type, (*array_)[position.value()]);
+}
+
+bool Lexeme::set_element(const Lexeme &index, const Lexeme &value) {
+    auto position = check_index(index);
+    if (!position.has_value()) {
+        return false;
+    }
+    if (type_subvalue_ != value.get_type_value()) {
+        std::cerr << "Operands must be of the same type." << std::endl;
+        return false;
+    }
+    detach_array();
+    (*array_)[position.value()] = value.scalar_;
+    return true;
+}
+
+std::string Lexeme::LexemeTypeToString(Lexeme::LexemeType type) {
     switch (type) {
         case IDENTIFIER:
             return "IDENTIFIER";
@@ -129,73 +281,63 @@ bool Lexeme::need_next(Lexeme::LexemeType next_type) const {
     return iter_found != next_types.end();
 }
 
-void Lexeme::print() const {
-    std::cout << "\t";
-    if (is_value()) {
-        switch (get_type_value()) {
-            case Lexeme::ValueType::INTEGER: {
-                std::cout << code_ << " = " << *reinterpret_cast<const int32_t *>(get_data().data()) << std::endl;
-                break;
-            }
-            case Lexeme::ValueType::FLOAT: {
-                std::cout << code_ << " = " << *reinterpret_cast<const float *>(get_data().data()) << std::endl;
-                break;
-            }
-            case Lexeme::ValueType::BOOL: {
-                std::cout << code_ << " = " << (*reinterpret_cast<const bool *>(get_data().data()) ? "true" : "false") << std::endl;
-                break;
-            }
-            case Lexeme::ValueType::ARR: {
-                std::cout << code_ << " = array[ ";
+void Lexeme::print_value(std::ostream &out) const {
+    switch (get_type_value()) {
+        case Lexeme::ValueType::INTEGER:
+            out << get_integer();
+            break;
+        case Lexeme::ValueType::FLOAT:
+            out << get_float();
+            break;
+        case Lexeme::ValueType::BOOL:
+            out << (get_bool() ? "true" : "false");
+            break;
+        case Lexeme::ValueType::ARR: {
+            out << "array[ ";
+            for (size_t i = 0; i < get_size(); ++i) {
                 switch (get_type_subvalue()) {
-                    case Lexeme::ValueType::INTEGER:{
-                        auto data = reinterpret_cast<const int32_t *>(get_data().data());
-                        for (size_t i = 0; i < get_data().size() / sizeof(int32_t); ++i)
-                        {
-                            std::cout << *data << " ";
-                            ++data;
-                        }
-                        break;
-                    }
-                    case Lexeme::ValueType::FLOAT:{
-                        auto data = reinterpret_cast<const float *>(get_data().data());
-                        for (size_t i = 0; i < get_data().size() / sizeof(float); ++i)
-                        {
-                            std::cout << *data << " ";
-                            ++data;
-                        }
+                    case Lexeme::ValueType::FLOAT:
+                        out << (*array_)[i].floating << " ";
                         break;
-                    }
-                    case Lexeme::ValueType::BOOL:{
-                        auto data = reinterpret_cast<const bool *>(get_data().data());
-                        for (size_t i = 0; i < get_data().size() / sizeof(bool); ++i)
-                        {
-                            std::cout << *data << " ";
-                            ++data;
-                        }
+                    case Lexeme::ValueType::BOOL:
+                        out << (*array_)[i].boolean << " ";
                         break;
-                    }
-                    default:{
-                        auto data = get_data().data();
-                        for (size_t i = 0; i < get_data().size() / sizeof(uint8_t); ++i)
-                        {
-                            std::cout << static_cast<short>(*data) << " ";
-                            ++data;
-                        }
+                    default:
+                        out << (*array_)[i].integer << " ";
                         break;
-                    }
                 }
-                std::cout << "]" << std::endl;
-                break;
             }
-            default:
-                std::cout << "Unknown type of value." << std::endl;
-                break;
+            out << "]";
+            break;
         }
+        default:
+            out << "Unknown type of value.";
+            break;
+    }
+}
+
+// у каждого потока свой поток вывода, чтобы сценарии, выполняемые параллельно, не перемешивали вывод
+static thread_local std::ostream *output = &std::cout;
+
+std::ostream &Lexeme::get_output() {
+    return *output;
+}
+
+void Lexeme::set_output(std::ostream &out) {
+    output = &out;
+}
+
+void Lexeme::print() const {
+    auto &out = get_output();
+    out << "\t";
+    if (is_value()) {
+        out << code_ << " = ";
+        print_value(out);
+        out << std::endl;
     } else if (is_action()) {
-        std::cout << code_ << " = function" << std::endl;
+        out << code_ << " = function" << std::endl;
     } else {
-        std::cout << code_ << std::endl;
+        out << code_ << std::endl;
     }
 }
 
@@ -204,75 +346,17 @@ void Lexeme::debug_print() const {
     std::cerr << "Type\t" << LexemeTypeToString(type_) << std::endl;
     if (is_value()) {
         std::cerr << "Contains value: ";
-        switch (get_type_value()) {
-            case Lexeme::ValueType::INTEGER: {
-                std::cerr << *reinterpret_cast<const int32_t *>(get_data().data()) << std::endl;
-                break;
-            }
-            case Lexeme::ValueType::FLOAT: {
-                std::cerr << *reinterpret_cast<const float *>(get_data().data()) << std::endl;
-                break;
-            }
-            case Lexeme::ValueType::BOOL: {
-                std::cerr << code_ << " = " << (*reinterpret_cast<const bool *>(get_data().data()) ? "true" : "false") << std::endl;
-                break;
-            }
-            case Lexeme::ValueType::ARR: {
-                std::cerr << code_ << " = array[ ";
-                switch (get_type_subvalue()) {
-                    case Lexeme::ValueType::INTEGER:{
-                        auto data = reinterpret_cast<const int32_t *>(get_data().data());
-                        for (size_t i = 0; i < get_data().size() / sizeof(int32_t); ++i)
-                        {
-                            std::cerr << *data << " ";
-                            ++data;
-                        }
-                        break;
-                    }
-                    case Lexeme::ValueType::FLOAT:{
-                        auto data = reinterpret_cast<const float *>(get_data().data());
-                        for (size_t i = 0; i < get_data().size() / sizeof(float); ++i)
-                        {
-                            std::cerr << *data << " ";
-                            ++data;
-                        }
-                        break;
-                    }
-                    case Lexeme::ValueType::BOOL:{
-                        auto data = reinterpret_cast<const bool *>(get_data().data());
-                        for (size_t i = 0; i < get_data().size() / sizeof(bool); ++i)
-                        {
-                            std::cerr << *data << " ";
-                            ++data;
-                        }
-                        break;
-                    }
-                    default:{
-                        auto data = get_data().data();
-                        for (size_t i = 0; i < get_data().size() / sizeof(uint8_t); ++i)
-                        {
-                            std::cerr << static_cast<short>(*data) << " ";
-                            ++data;
-                        }
-                        break;
-                    }
-                }
-                std::cerr << "]" << std::endl;
-                break;
-            }
-            default:
-                std::cerr << "Unknown type of value." << std::endl;
-                break;
-        }
+        print_value(std::cerr);
+        std::cerr << std::endl;
     }
-    if (is_value()) {
+    if (is_action()) {
         std::cerr << "Contains action" << std::endl;
     }
 }
 
 bool Lexeme::is_action() const {return static_cast<bool>(action_);}
 
-bool Lexeme::is_value() const {return !data_.empty();}
+bool Lexeme::is_value() const {return type_value_ != NONE;}
 
 Lexeme Lexeme::exec_action(Lexeme &lhs, Lexeme &rhs) const {
     return action_(lhs, rhs);
@@ -3,7 +3,11 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include <cstdint>
 #include <functional>
+#include <optional>
+#include <ostream>
 
 /**
  * @brief Описывает лексему и
@@ -60,7 +64,7 @@ public:
      * @param type Тип лексемы.
      * @return Название лексемы.
      */
-    static std::__cxx11::string LexemeTypeToString(LexemeType type);
+    static std::string LexemeTypeToString(LexemeType type);
 
     // далее следуют общие методы для всех лексем
 
@@ -70,7 +74,7 @@ public:
      * @param type Тип лексемы.
      * @param code Её символьное представление в коде.
      */
-    Lexeme(LexemeType type, const std::__cxx11::string &code) : type_(type), code_(code){}
+    Lexeme(LexemeType type, const std::string &code) : type_(type), code_(code){}
 
     virtual ~Lexeme() = default;
 
@@ -84,8 +88,8 @@ public:
     bool operator!=(const Lexeme& rhs) const;
 
     // методы для получения и установки символьного представления лексемы в коде
-    const std::__cxx11::string &get_code() const;
-    void set_code(const std::__cxx11::string &code);
+    const std::string &get_code() const;
+    void set_code(const std::string &code);
 
     // методы для получения и установки типа лексемы
     LexemeType get_type() const;
@@ -102,6 +106,18 @@ public:
     void print() const;;
     void debug_print() const;;
 
+    /**
+     * @brief Поток, в который print выводит информацию в текущем потоке выполнения. По умолчанию - std::cout.
+     * @return Поток вывода.
+     */
+    static std::ostream &get_output();
+
+    /**
+     * @brief Перенаправить вывод print в текущем потоке выполнения.
+     * @param out Поток вывода. Должен существовать, пока в него выводится информация.
+     */
+    static void set_output(std::ostream &out);
+
     /**
      * @brief Содержит ли лексема действие.
      * @return True, если лексема содержит действие, иначе - false.
@@ -128,14 +144,31 @@ public:
     };
 
     /**
-     * @brief Конструтор лексемы, содержащей данные.
+     * @brief Скалярное значение: 64-битное целое число, число с плавающей точкой двойной точности или логическое значение.
+     * @details Хранится прямо в лексеме, поэтому скалярная арифметика не обращается к куче.
+     */
+    union Scalar {
+        int64_t integer;
+        double floating;
+        bool boolean;
+
+        Scalar() : integer(0) {}
+        Scalar(int32_t value) : integer(value) {}
+        Scalar(int64_t value) : integer(value) {}
+        Scalar(float value) : floating(value) {}
+        Scalar(double value) : floating(value) {}
+        Scalar(bool value) : boolean(value) {}
+    };
+
+    /**
+     * @brief Конструтор лексемы, содержащей скалярные данные.
      * @param type Тип лексемы.
      * @param code Символьное представление в коде.
      * @param type_value Тип данных, содержащихся в лексеме.
-     * @param data Данные. Массив байт.
+     * @param value Значение.
      */
-    Lexeme(LexemeType type, const std::__cxx11::string &code, ValueType type_value, const std::vector<uint8_t> &data)
-    : type_(type), code_(code), type_value_(type_value), data_(data) {}
+    Lexeme(LexemeType type, const std::string &code, ValueType type_value, Scalar value)
+    : type_(type), code_(code), type_value_(type_value), scalar_(value) {}
 
     // методы получения и установки типа данных
     ValueType get_type_value() const;
@@ -145,9 +178,74 @@ public:
     ValueType get_type_subvalue() const;
     void set_type_subvalue(ValueType type_value_);
 
-    // получение и установка данных
-    const std::vector<uint8_t> &get_data() const;
-    void set_data(const std::vector<uint8_t> &data);
+    // получение и установка скалярных данных
+    int64_t get_integer() const;
+    double get_float() const;
+    bool get_bool() const;
+    Scalar get_scalar() const;
+    void set_integer(int64_t value);
+    void set_float(double value);
+    void set_bool(bool value);
+
+    /**
+     * @brief Скопировать значение (тип данных и сами данные) из другой лексемы.
+     * @details Буфер массива не копируется, а разделяется до первого изменения одной из лексем.
+     * @param other Лексема, значение которой копируется.
+     */
+    void set_value(const Lexeme &other);
+
+    /**
+     * @brief Сравнить значения двух лексем.
+     * @param other Лексема, с которой сравниваем.
+     * @return True, если типы и значения совпадают, иначе - false.
+     */
+    bool value_equals(const Lexeme &other) const;
+
+    /**
+     * @brief Получить элементы массива.
+     * @return Непрерывный буфер элементов. Пуст, если лексема не является массивом.
+     */
+    const std::vector<Scalar> &get_array() const;
+
+    /**
+     * @brief Сделать значение лексемы массивом.
+     * @param type_subvalue Тип элементов массива.
+     * @param elements Элементы массива.
+     */
+    void set_array(ValueType type_subvalue, std::vector<Scalar> elements);
+
+    /**
+     * @brief Количество элементов массива.
+     * @return Длина массива или 0, если лексема не является массивом.
+     */
+    size_t get_size() const;
+
+    /**
+     * @brief Превратить значение лексемы в массив из одного элемента.
+     */
+    void wrap_into_array();
+
+    /**
+     * @brief Добавить элемент в конец массива.
+     * @param element Лексема, значение которой добавляется.
+     * @return False, если тип элемента не совпадает с типом элементов массива. Иначе - true.
+     */
+    bool push_back_element(const Lexeme &element);
+
+    /**
+     * @brief Прочитать элемент массива.
+     * @param index Лексема, содержащая целочисленный индекс.
+     * @return Лексема, содержащая значение элемента, если операция допустима.
+     */
+    std::optional<Lexeme> get_element(const Lexeme &index) const;
+
+    /**
+     * @brief Записать элемент массива.
+     * @param index Лексема, содержащая целочисленный индекс.
+     * @param value Лексема, содержащая новое значение элемента.
+     * @return True, если операция допустима, иначе - false.
+     */
+    bool set_element(const Lexeme &index, const Lexeme &value);
 
 
     // далее следуют методы для лексем, содержащих действие
@@ -158,7 +256,7 @@ public:
      * @param code Символьное представление в коде.
      * @param action Функция, которую содержит лексема.
      */
-    Lexeme(LexemeType type, const std::__cxx11::string &code, const std::function<Lexeme(Lexeme &, Lexeme &)> &action)
+    Lexeme(LexemeType type, const std::string &code, const std::function<Lexeme(Lexeme &, Lexeme &)> &action)
     : type_(type), code_(code), action_(action) {}
 
     /**
@@ -171,12 +269,13 @@ public:
 
 
 private:
-    LexemeType type_;
-    std::__cxx11::string code_;
+    LexemeType type_ { STATEMENT };
+    std::string code_;
 
     ValueType type_value_ { NONE };
     ValueType type_subvalue_ { NONE };
-    std::vector<uint8_t> data_;
+    Scalar scalar_;
+    std::shared_ptr<std::vector<Scalar>> array_;
 
     std::function<Lexeme(Lexeme &lhs, Lexeme &rhs)> action_;
 
@@ -190,6 +289,24 @@ private:
      * @return Массив типов лексем, которые должны быть обязательно считаны после данной.
      */
     std::vector<LexemeType> need_next_types() const;
+
+    /**
+     * @brief Получить собственную копию буфера массива перед его изменением.
+     */
+    void detach_array();
+
+    /**
+     * @brief Вывести значение лексемы в поток.
+     * @param out Поток вывода.
+     */
+    void print_value(std::ostream &out) const;
+
+    /**
+     * @brief Проверить индекс элемента массива.
+     * @param index Лексема, содержащая индекс.
+     * @return Позиция элемента, если индекс допустим.
+     */
+    std::optional<size_t> check_index(const Lexeme &index) const;
 };
 
 #endif //MADEALGORITHMSHOMEWORK2_LEXEME_H
@@ -1,99 +1,147 @@
 #include <iostream>
+#include <array>
+#include <charconv>
 
 #include "Lexer.h"
 
+/**
+ * @brief Классы символов исходного кода.
+ */
+enum SymbolClass : uint8_t {
+    OTHER,
+    SPACE,
+    DIGIT,
+    ALPHA,
+    BRACKET,
+    PUNCT
+};
 
-std::vector<Lexeme> Lexer::parse_code(const std::string &code, const Grammar &grammar) {
-    std::vector<Lexeme> lexemes;
+/**
+ * @brief Таблица классов символов, вычисляемая при компиляции.
+ * @details Заменяет вызовы std::isspace, std::isdigit и т.д., которые зависят от локали и не встраиваются.
+ */
+static constexpr std::array<SymbolClass, 256> symbol_classes = [] {
+    std::array<SymbolClass, 256> classes{};
+    for (auto symbol: {' ', '\t', '\n', '\v', '\f', '\r'}) {
+        classes[static_cast<uint8_t>(symbol)] = SPACE;
+    }
+    for (auto symbol = '0'; symbol <= '9'; ++symbol) {
+        classes[static_cast<uint8_t>(symbol)] = DIGIT;
+    }
+    for (auto symbol = 'a'; symbol <= 'z'; ++symbol) {
+        classes[static_cast<uint8_t>(symbol)] = ALPHA;
+        classes[static_cast<uint8_t>(symbol - 'a' + 'A')] = ALPHA;
+    }
+    for (auto symbol: std::string_view("!\"#$%&'*+,-./:;<=>?@\\^_`|~")) {
+        classes[static_cast<uint8_t>(symbol)] = PUNCT;
+    }
+    for (auto symbol: std::string_view("()[]{}")) {
+        classes[static_cast<uint8_t>(symbol)] = BRACKET;
+    }
+    return classes;
+}();
+
+static SymbolClass symbol_class(char symbol) {
+    return symbol_classes[static_cast<uint8_t>(symbol)];
+}
+
+std::vector<Lexer::Token> Lexer::tokenize(std::string_view code, const Grammar &grammar) {
+    std::vector<Token> tokens;
     size_t current = 0;
     while (current < code.size()) {
-        if (std::isspace(code[current])) {  // пробелы просто игнорируем
-            current += 1;
-            continue;
-        } else if (std::isdigit(code[current])) {
-            // parse numeric constant
-            std::string lexeme_text;
-            bool is_integer = true;
-            while (current < code.size() && (std::isdigit(code[current]) || code[current] == '.')) {
-                if (code[current] == '.') {
-                    is_integer = false;
-                }
-                lexeme_text += code[current];
+        const size_t begin = current;
+        switch (symbol_class(code[current])) {
+            case SPACE: {  // пробелы просто игнорируем
                 current += 1;
+                continue;
             }
-            auto found = grammar.find_lexeme(lexeme_text);  // ищем лексему в грамматике языка
-            if (found.has_value()) {
-                lexemes.push_back(found.value());
-            } else {  // если не нашли, то создаём лексему, соответствующую константе
+            case DIGIT: {
+                // parse numeric constant
+                bool is_integer = true;
+                while (current < code.size() && (symbol_class(code[current]) == DIGIT || code[current] == '.')) {
+                    if (code[current] == '.') {
+                        is_integer = false;
+                    }
+                    current += 1;
+                }
+                Token token{code.substr(begin, current - begin), Lexeme::LexemeType::CONSTANT};
+                const auto first = code.data() + begin;
+                const auto last = code.data() + current;
+                std::from_chars_result parsed{};
                 if (is_integer) {
-                    auto value = std::stoi(lexeme_text);
-                    std::vector<uint8_t> data(sizeof(value));
-                    *const_cast<int32_t *>(reinterpret_cast<const int32_t *>(data.data())) = value;
-                    Lexeme lexeme(Lexeme::LexemeType::CONSTANT, lexeme_text, Lexeme::ValueType::INTEGER, data);
-                    lexemes.push_back(lexeme);
+                    token.type_value = Lexeme::ValueType::INTEGER;
+                    parsed = std::from_chars(first, last, token.value.integer);
                 } else {
-                    auto value = std::stof(lexeme_text);
-                    std::vector<uint8_t> data(sizeof(value));
-                    *const_cast<float *>(reinterpret_cast<const float *>(data.data())) = value;
-                    Lexeme lexeme(Lexeme::LexemeType::CONSTANT, lexeme_text, Lexeme::ValueType::FLOAT, data);
-                    lexemes.push_back(lexeme);
+                    token.type_value = Lexeme::ValueType::FLOAT;
+                    parsed = std::from_chars(first, last, token.value.floating);
                 }
+                if (parsed.ec != std::errc()) {
+                    throw std::runtime_error("Wrong numeric constant: " + std::string(token.text));
+                }
+                tokens.push_back(token);
+                continue;
             }
-        } else if ((std::ispunct(code[current])) && !isbracket(code[current])) {  // оператор
-            // parse operator or keyword
-            std::string lexeme_text;
-            while ((current < code.size()) && std::ispunct(code[current]) && !isbracket(code[current])) {
-                lexeme_text += code[current];
+            case PUNCT:  // оператор
+                // parse operator or keyword
+                while ((current < code.size()) && (symbol_class(code[current]) == PUNCT)) {
+                    current += 1;
+                }
+                break;
+            case BRACKET:  // скобка
                 current += 1;
+                break;
+            case ALPHA: {  // идентификатор
+                // parse id
+                while (current < code.size() &&
+                       (symbol_class(code[current]) == ALPHA || symbol_class(code[current]) == DIGIT)) {
+                    current += 1;
+                }
+                auto text = code.substr(begin, current - begin);
+                auto keyword = grammar.find_keyword(text);
+                if (keyword == nullptr) {
+                    tokens.push_back({text, Lexeme::LexemeType::IDENTIFIER});
+                } else {
+                    tokens.push_back({text, keyword->get_type(), keyword->get_type_value(), keyword->get_scalar()});
+                }
+                continue;
             }
-            auto found = grammar.find_lexeme(lexeme_text);
-            if (found.has_value()) {
-                lexemes.push_back(found.value());
-            } else {
-                std::cerr << "Unknown lexeme: " << lexeme_text << std::endl;
-                throw std::runtime_error("Unknown lexeme: " + lexeme_text);
-            }
-        }  else if (isbracket(code[current])) {  // скобка
-            // parse bracket
-            std::string lexeme_text;
-            lexeme_text += code[current];
-            current += 1;
-            auto found = grammar.find_lexeme(lexeme_text);
-            if (found.has_value()) {
-                lexemes.push_back(found.value());
-            } else {
-                std::cerr << "Unknown lexeme: " << lexeme_text << std::endl;
-                throw std::runtime_error("Unknown lexeme: " + lexeme_text);
-            }
-        } else if (std::isalpha(code[current])) {  // идентификатор
-            // parse id
-            std::string lexeme_text;
-            while (current < code.size() && (std::isalpha(code[current]) || std::isdigit(code[current]))) {
-                lexeme_text += code[current];
+            default:
                 current += 1;
-            }
-            auto found = grammar.find_lexeme(lexeme_text);
+                break;
+        }
+        // операторы и скобки обязаны быть встроенными лексемами
+        auto text = code.substr(begin, current - begin);
+        auto keyword = grammar.find_keyword(text);
+        if (keyword == nullptr) {
+            throw std::runtime_error("Unknown lexeme: " + std::string(text));
+        }
+        tokens.push_back({text, keyword->get_type()});
+    }
+    return tokens;
+}
+
+std::vector<Lexeme> Lexer::parse_code(std::string_view code, const Grammar &grammar) {
+    auto tokens = tokenize(code, grammar);
+    std::vector<Lexeme> lexemes;
+    lexemes.reserve(tokens.size());
+    for (const auto &token: tokens) {
+        if (symbol_class(token.text.front()) == DIGIT) {  // числовая константа
+            lexemes.emplace_back(token.type, std::string(token.text), token.type_value, token.value);
+        } else if (symbol_class(token.text.front()) == ALPHA) {
+            // переменные, функции и константы берём из грамматики вместе с их текущими значениями
+            auto found = grammar.find_lexeme(std::string(token.text));
             if (found.has_value()) {
                 lexemes.push_back(found.value());
             } else {
-                Lexeme lexeme(Lexeme::LexemeType::IDENTIFIER, lexeme_text);
-                lexemes.push_back(lexeme);
+                lexemes.emplace_back(Lexeme::LexemeType::IDENTIFIER, std::string(token.text));
             }
+        } else {
+            lexemes.push_back(*grammar.find_keyword(token.text));
         }
     }
     return lexemes;
 }
 
 bool Lexer::isbracket(char symbol) {
-    switch (symbol){
-        case '(':
-        case ')':
-        case '[':
-        case ']':
-        case '{':
-        case '}':
-            return true;
-        default:
-            return false;
-    }
+    return symbol_class(symbol) == BRACKET;
 }
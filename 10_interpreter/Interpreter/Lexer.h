@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <set>
+#include <string_view>
 
 #include "Grammar.h"
 
@@ -14,13 +15,33 @@ public:
     Lexer() = default;
     ~Lexer() = default;
 
+    /**
+     * @brief Лёгкая лексема: ссылается на текст исходного кода и не владеет памятью.
+     * @details Для числовых констант значение уже разобрано, для встроенных лексем известен тип.
+     * Токен действителен, пока жив буфер с исходным кодом.
+     */
+    struct Token {
+        std::string_view text;
+        Lexeme::LexemeType type{Lexeme::LexemeType::IDENTIFIER};
+        Lexeme::ValueType type_value{Lexeme::ValueType::NONE};
+        Lexeme::Scalar value{};
+    };
+
+    /**
+     * @brief Разбить код на токены без копирования текста.
+     * @param code Код. Может содержать много строк и операторов.
+     * @param grammar Грамматика языка.
+     * @return Набор токенов, ссылающихся на code.
+     */
+    static std::vector<Token> tokenize(std::string_view code, const Grammar& grammar);
+
     /**
      * @brief Произвести разбор строки кода.
-     * @param code Строка кода.
+     * @param code Код: одна строка или целый скрипт.
      * @param grammar Грамматика языка.
      * @return Набор лексем, соответствующие входной строке.
      */
-    static std::vector<Lexeme> parse_code(const std::string& code, const Grammar& grammar);
+    static std::vector<Lexeme> parse_code(std::string_view code, const Grammar& grammar);
 
     /**
      * @brief Проверяет, является ли символ скобкой.
@@ -0,0 +1,219 @@
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Optimizer.h"
+
+void Optimizer::optimize(Program &program, const Grammar &grammar) {
+    fold(program, grammar);
+    eliminate_dead_stores(program);
+}
+
+void Optimizer::fold(Program &program, const Grammar &grammar) {
+    /*
+     * Программа линейна, поэтому достаточно одного прохода с моделью стека машины.
+     * Для каждого значения на стеке помним, с какой инструкции начинается его вычисление:
+     * всё, что записано в результат после неё, относится к этому значению и значениям выше него.
+     */
+    std::vector<Program::Instruction> code;
+    std::vector<StackEntry> stack;
+    // типы переменных, которые известны до выполнения: им присвоены значения известного типа
+    std::unordered_map<uint32_t, Lexeme::ValueType> variable_types;
+    auto pop = [&stack]() {
+        auto entry = stack.back();
+        stack.pop_back();
+        return entry;
+    };
+    for (const auto &instruction: program.get_code()) {
+        const auto &lexemes = program.get_lexemes();
+        switch (instruction.code) {
+            case Program::OpCode::PUSH:
+                stack.push_back({code.size(), instruction.operand, true,
+                                 lexemes[instruction.operand].get_type_value()});
+                break;
+            case Program::OpCode::LOAD: {
+                auto type = variable_types.find(instruction.operand);
+                stack.push_back({code.size(), std::nullopt, true,
+                                 (type != variable_types.end()) ? std::optional(type->second) : std::nullopt});
+                break;
+            }
+            case Program::OpCode::BINARY: {
+                auto rhs = pop();
+                auto lhs = pop();
+                const auto &action = lexemes[instruction.action];
+                if (lhs.constant.has_value() && rhs.constant.has_value() &&
+                    can_fold(action, lexemes[lhs.constant.value()], &lexemes[rhs.constant.value()])) {
+                    auto lhs_value = lexemes[lhs.constant.value()];
+                    auto rhs_value = lexemes[rhs.constant.value()];
+                    auto result = action.exec_action(lhs_value, rhs_value);
+                    code.resize(lhs.start);
+                    auto index = program.add_lexeme(result);
+                    code.push_back({Program::OpCode::PUSH, index});
+                    stack.push_back({lhs.start, index, true, result.get_type_value()});
+                    continue;
+                }
+                // упрощения не проверяют типы, поэтому применяются, только если тип x заранее известен и совпадает с типом константы
+                if (rhs.constant.has_value() && !lhs.constant.has_value() &&
+                    (lhs.type == lexemes[rhs.constant.value()].get_type_value())) {
+                    const auto &value = lexemes[rhs.constant.value()];
+                    bool is_zero = ((value.get_type_value() == Lexeme::ValueType::INTEGER) && (value.get_integer() == 0)) ||
+                                   ((value.get_type_value() == Lexeme::ValueType::FLOAT) && (value.get_float() == 0.0));
+                    bool is_one = ((value.get_type_value() == Lexeme::ValueType::INTEGER) && (value.get_integer() == 1)) ||
+                                  ((value.get_type_value() == Lexeme::ValueType::FLOAT) && (value.get_float() == 1.0));
+                    bool is_two = ((value.get_type_value() == Lexeme::ValueType::INTEGER) && (value.get_integer() == 2)) ||
+                                  ((value.get_type_value() == Lexeme::ValueType::FLOAT) && (value.get_float() == 2.0));
+                    const auto &operation = action.get_code();
+                    if ((is_zero && ((operation == "+") || (operation == "-"))) ||
+                        (is_one && ((operation == "*") || (operation == "/")))) {
+                        // x + 0, x - 0, x * 1, x / 1: значение x не меняется
+                        code.resize(rhs.start);
+                        stack.push_back({lhs.start, std::nullopt, false, lhs.type});
+                        continue;
+                    }
+                    auto plus = grammar.find_keyword("+");
+                    if (is_two && (operation == "*") && (plus != nullptr)) {
+                        // x * 2 = x + x: сложение дешевле умножения и не требует константы
+                        code.resize(rhs.start);
+                        code.push_back({Program::OpCode::DUP});
+                        code.push_back({Program::OpCode::BINARY, 0, program.add_action(*plus)});
+                        stack.push_back({lhs.start, std::nullopt, false, lhs.type});
+                        continue;
+                    }
+                }
+                stack.push_back({lhs.start, std::nullopt, false, std::nullopt});
+                break;
+            }
+            case Program::OpCode::UNARY: {
+                auto operand = pop();
+                const auto &action = lexemes[instruction.action];
+                if (operand.constant.has_value() && can_fold(action, lexemes[operand.constant.value()], nullptr)) {
+                    auto value = lexemes[operand.constant.value()];
+                    auto dummy = Lexeme();
+                    auto result = action.exec_action(value, dummy);
+                    code.resize(operand.start);
+                    auto index = program.add_lexeme(result);
+                    code.push_back({Program::OpCode::PUSH, index});
+                    stack.push_back({operand.start, index, true, result.get_type_value()});
+                    continue;
+                }
+                stack.push_back({operand.start, std::nullopt, false, std::nullopt});
+                break;
+            }
+            case Program::OpCode::MAKE_LIST: {
+                // превращение значения в массив не может завершиться ошибкой
+                auto element = pop();
+                stack.push_back({element.start, std::nullopt, element.is_simple, Lexeme::ValueType::ARR});
+                break;
+            }
+            case Program::OpCode::APPEND_LIST: {
+                pop();
+                auto list = pop();
+                stack.push_back({list.start, std::nullopt, false, Lexeme::ValueType::ARR});
+                break;
+            }
+            case Program::OpCode::LOAD_ELEMENT: {
+                auto index = pop();
+                stack.push_back({index.start, std::nullopt, false, std::nullopt});
+                break;
+            }
+            case Program::OpCode::STORE: {
+                auto value = pop();
+                if (value.type.has_value()) {
+                    variable_types[instruction.operand] = value.type.value();
+                } else {
+                    variable_types.erase(instruction.operand);
+                }
+                break;
+            }
+            case Program::OpCode::ECHO:
+                pop();
+                break;
+            case Program::OpCode::STORE_ELEMENT:
+                pop();
+                pop();
+                break;
+            case Program::OpCode::DUP: {
+                auto entry = stack.back();
+                stack.push_back({code.size(), entry.constant, false, entry.type});
+                break;
+            }
+            case Program::OpCode::POP: {
+                auto entry = pop();
+                if (entry.is_simple) {
+                    // константа или значение переменной никуда не сохраняется: его не нужно и вычислять
+                    code.resize(entry.start);
+                    continue;
+                }
+                break;
+            }
+        }
+        code.push_back(instruction);
+    }
+    program.set_code(std::move(code));
+}
+
+void Optimizer::eliminate_dead_stores(Program &program) {
+    /*
+     * Идём с конца программы и помним переменные, которые будут перезаписаны раньше, чем прочитаны.
+     * Последнее сохранение каждой переменной всегда нужно: переменные живут и после программы.
+     * Ошибка при работе с элементами массива отменяет сохранение в операторе, поэтому через неё сохранения не удаляются.
+     */
+    auto code = program.get_code();
+    std::unordered_set<uint32_t> overwritten;
+    for (auto instruction = code.rbegin(); instruction != code.rend(); ++instruction) {
+        switch (instruction->code) {
+            case Program::OpCode::STORE:
+                if (overwritten.count(instruction->operand) > 0) {
+                    instruction->code = Program::OpCode::ECHO;
+                } else {
+                    overwritten.insert(instruction->operand);
+                }
+                break;
+            case Program::OpCode::LOAD:
+                overwritten.erase(instruction->operand);
+                break;
+            case Program::OpCode::LOAD_ELEMENT:
+            case Program::OpCode::STORE_ELEMENT:
+                overwritten.clear();
+                break;
+            default:
+                break;
+        }
+    }
+    program.set_code(std::move(code));
+}
+
+bool Optimizer::can_fold(const Lexeme &action, const Lexeme &lhs, const Lexeme *rhs) {
+    const auto &operation = action.get_code();
+    const auto type = lhs.get_type_value();
+    const bool is_number = (type == Lexeme::ValueType::INTEGER) || (type == Lexeme::ValueType::FLOAT);
+    if (rhs == nullptr) {
+        if (operation == "sqrt") {
+            return type == Lexeme::ValueType::FLOAT;
+        }
+        if (operation == "square") {
+            return is_number;
+        }
+        if (operation == "!") {
+            return type == Lexeme::ValueType::BOOL;
+        }
+        return false;
+    }
+    if (type != rhs->get_type_value()) {
+        return false;
+    }
+    if ((operation == "+") || (operation == "-") || (operation == "*") ||
+        (operation == "<") || (operation == ">") || (operation == "<=") || (operation == ">=")) {
+        return is_number;
+    }
+    if (operation == "/") {
+        // целочисленное деление на ноль оставляем до выполнения
+        return (type == Lexeme::ValueType::FLOAT) || ((type == Lexeme::ValueType::INTEGER) && (rhs->get_integer() != 0));
+    }
+    if ((operation == "==") || (operation == "!=")) {
+        return is_number || (type == Lexeme::ValueType::BOOL);
+    }
+    if ((operation == "&&") || (operation == "||") || (operation == "^")) {
+        return type == Lexeme::ValueType::BOOL;
+    }
+    return false;
+}
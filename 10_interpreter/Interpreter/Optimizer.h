@@ -0,0 +1,69 @@
+#ifndef MADEALGORITHMSHOMEWORK2_OPTIMIZER_H
+#define MADEALGORITHMSHOMEWORK2_OPTIMIZER_H
+
+#include <optional>
+
+#include "Grammar.h"
+#include "Lexeme.h"
+#include "Program.h"
+
+/**
+ * @brief Оптимизатор скомпилированных программ.
+ * @details Выполняет за один проход по инструкциям:
+ * * свёртку константных подвыражений, в том числе вызовов чистых функций sqrt и square;
+ * * упрощение выражений: x + 0, x - 0, x * 1, x / 1 заменяются на x, а x * 2 - на x + x;
+ * * удаление вычислений, значения которых не используются;
+ * * удаление сохранения переменных, которые перезаписываются до чтения (значение при этом печатается, как и раньше).
+ * @details Константы сворачиваются, только если операция выполнится без ошибок,
+ * поэтому сообщения об ошибках в программе не теряются. Упрощения выполняются, только если тип x известен
+ * заранее и совпадает с типом константы: x - константа или переменная, которой в этой же программе присвоено
+ * значение известного типа.
+ */
+class Optimizer {
+public:
+    Optimizer() = default;
+    ~Optimizer() = default;
+
+    /**
+     * @brief Оптимизировать программу.
+     * @param program Программа. Изменяется на месте.
+     * @param grammar Грамматика языка, из которой берутся действия для упрощённых выражений.
+     */
+    static void optimize(Program &program, const Grammar &grammar);
+
+private:
+    /**
+     * @brief Значение на стеке машины во время анализа программы.
+     */
+    struct StackEntry {
+        size_t start;                       // с какой инструкции начинается вычисление значения
+        std::optional<uint32_t> constant;   // индекс лексемы, если значение известно заранее
+        bool is_simple;                     // значение получено без действий, которые могут что-то напечатать
+        std::optional<Lexeme::ValueType> type;  // тип значения, если он известен заранее
+    };
+
+    /**
+     * @brief Свернуть константы и упростить выражения.
+     * @param program Программа.
+     * @param grammar Грамматика языка.
+     */
+    static void fold(Program &program, const Grammar &grammar);
+
+    /**
+     * @brief Заменить сохранение переменных, которые перезаписываются до чтения, на печать.
+     * @param program Программа.
+     */
+    static void eliminate_dead_stores(Program &program);
+
+    /**
+     * @brief Можно ли заранее выполнить действие над известными значениями.
+     * @param action Лексема, содержащая действие.
+     * @param lhs Первый аргумент.
+     * @param rhs Второй аргумент или nullptr для функций одного аргумента.
+     * @return True, если действие чистое и выполнится без ошибок.
+     */
+    static bool can_fold(const Lexeme &action, const Lexeme &lhs, const Lexeme *rhs);
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_OPTIMIZER_H
@@ -0,0 +1,123 @@
+#include <queue>
+
+#include "ParseTable.h"
+#include "Convolution.h"
+
+ParseTable::ParseTable(const std::vector<Convolution> &convolutions) {
+    /*
+     * Вначале строим бор по последовательностям лексем, которые сворачивают свёртки.
+     * В узле бора запоминаем свёртку, последовательность которой заканчивается в этом узле.
+     */
+    struct Node {
+        std::array<std::optional<size_t>, lexeme_types_count> children;
+        std::array<size_t, lexeme_types_count> go{};
+        std::optional<size_t> convolution;
+        std::optional<size_t> longest;
+        size_t link{0};
+    };
+    std::vector<Node> trie(1);
+    for (size_t i = 0; i < convolutions.size(); ++i) {
+        size_t node = 0;
+        for (auto type: convolutions[i].get_from()) {
+            if (!trie[node].children[type].has_value()) {
+                trie[node].children[type] = trie.size();
+                trie.emplace_back();
+            }
+            node = trie[node].children[type].value();
+        }
+        if (!trie[node].convolution.has_value()) {  // при одинаковых последовательностях выигрывает первая свёртка
+            trie[node].convolution = i;
+        }
+    }
+
+    /*
+     * Достраиваем бор до автомата Ахо-Корасик обходом в ширину.
+     * Узел автомата соответствует самому длинному концу стека, который является началом какой-либо свёртки.
+     * Для каждого узла находим самую длинную свёртку, которой заканчивается стек.
+     * Она либо заканчивается в самом узле, либо является концом строки, на которую указывает суффиксная ссылка.
+     */
+    std::queue<size_t> queue;
+    for (size_t type = 0; type < lexeme_types_count; ++type) {
+        if (trie[0].children[type].has_value()) {
+            trie[0].go[type] = trie[0].children[type].value();
+            queue.push(trie[0].go[type]);
+        }
+    }
+    while (!queue.empty()) {
+        auto node = queue.front();
+        queue.pop();
+        const auto link = trie[node].link;
+        trie[node].longest = trie[node].convolution.has_value() ? trie[node].convolution : trie[link].longest;
+        for (size_t type = 0; type < lexeme_types_count; ++type) {
+            if (trie[node].children[type].has_value()) {
+                auto child = trie[node].children[type].value();
+                trie[child].link = trie[link].go[type];
+                trie[node].go[type] = child;
+                queue.push(child);
+            } else {
+                trie[node].go[type] = trie[link].go[type];
+            }
+        }
+    }
+
+    /*
+     * Состояние анализатора - это узел автомата и тип последней лексемы в стеке.
+     * Обходим все достижимые состояния и для каждого перехода заранее решаем, нужно ли читать следующую лексему:
+     * * если стек пуст;
+     * * если после последней лексемы стека всегда нужно читать лексему такого типа;
+     * * если свёртку применить пока нельзя, а после чтения стек будет заканчиваться какой-либо свёрткой;
+     * * если прочитанная лексема продолжает начало свёртки, которым заканчивается стек.
+     * Последнее правило не зависит от того, что лежит в стеке глубже, поэтому, например,
+     * присваивание элементу массива разбирается одинаково в начале программы и после других операторов.
+     * Готовая свёртка применяется раньше чтения лексем, которые её не продолжают,
+     * поэтому разобранные операторы не накапливаются в стеке.
+     */
+    struct State {
+        size_t node;
+        size_t top;
+    };
+    const size_t no_top = lexeme_types_count;
+    std::vector<State> states;
+    std::vector<std::optional<size_t>> state_ids(trie.size() * (no_top + 1));
+    auto get_state_id = [&states, &state_ids, no_top](const State &state) {
+        auto key = state.node * (no_top + 1) + state.top;
+        if (!state_ids[key].has_value()) {
+            state_ids[key] = states.size();
+            states.push_back(state);
+        }
+        return state_ids[key].value();
+    };
+
+    get_state_id({0, no_top});
+    for (size_t id = 0; id < states.size(); ++id) {
+        const auto state = states[id];
+        reductions_.push_back(trie[state.node].longest);
+        transitions_.emplace_back();
+        for (size_t type = 0; type < lexeme_types_count; ++type) {
+            auto next_type = static_cast<Lexeme::LexemeType>(type);
+            auto next_node = trie[state.node].go[type];
+            bool need_next = (state.top == no_top) ||
+                             Lexeme(static_cast<Lexeme::LexemeType>(state.top), "").need_next(next_type) ||
+                             (!trie[state.node].longest.has_value() && trie[next_node].longest.has_value()) ||
+                             trie[state.node].children[type].has_value();
+            auto next_id = get_state_id({next_node, type});
+            transitions_[id][type] = {next_id, need_next};
+        }
+    }
+}
+
+bool ParseTable::need_next(size_t state, Lexeme::LexemeType next_type) const {
+    return transitions_[state][next_type].need_next;
+}
+
+size_t ParseTable::next_state(size_t state, Lexeme::LexemeType next_type) const {
+    return transitions_[state][next_type].state;
+}
+
+std::optional<size_t> ParseTable::find_convolution(size_t state) const {
+    return reductions_[state];
+}
+
+size_t ParseTable::states_count() const {
+    return transitions_.size();
+}
@@ -0,0 +1,81 @@
+#ifndef MADEALGORITHMSHOMEWORK2_PARSETABLE_H
+#define MADEALGORITHMSHOMEWORK2_PARSETABLE_H
+
+#include <array>
+#include <vector>
+#include <optional>
+
+#include "Lexeme.h"
+
+class Convolution;
+
+/**
+ * @brief Таблица переходов синтаксического анализатора.
+ * @details Строится один раз по набору свёрток грамматики и заменяет перебор свёрток на каждом шаге анализа.
+ * @details Состояние анализатора - это узел автомата Ахо-Корасик, построенного по последовательностям лексем,
+ * которые сворачивают свёртки, дополненный типом последней лексемы в стеке.
+ * @details Анализатор хранит стек состояний параллельно стеку лексем, поэтому каждый шаг выполняется за O(1).
+ */
+class ParseTable {
+public:
+    /**
+     * @brief Количество различных типов лексем.
+     */
+    static constexpr size_t lexeme_types_count = Lexeme::LexemeType::LIST + 1;
+
+    /**
+     * @brief Состояние анализатора с пустым стеком.
+     */
+    static constexpr size_t initial_state = 0;
+
+    ParseTable() = default;
+
+    /**
+     * @brief Построить таблицу по набору свёрток.
+     * @param convolutions Свёртки грамматики. Порядок свёрток важен: при равной длине выбирается первая.
+     */
+    explicit ParseTable(const std::vector<Convolution> &convolutions);
+
+    /**
+     * @brief Требуется ли чтение следующей лексемы при синтаксическом анализе.
+     * @param state Текущее состояние анализатора.
+     * @param next_type Тип следующей лексемы.
+     * @return True, если нужно читать следующую лексему, иначе - false.
+     */
+    bool need_next(size_t state, Lexeme::LexemeType next_type) const;
+
+    /**
+     * @brief Состояние анализатора после помещения лексемы в стек.
+     * @param state Текущее состояние анализатора.
+     * @param next_type Тип помещаемой лексемы.
+     * @return Новое состояние.
+     */
+    size_t next_state(size_t state, Lexeme::LexemeType next_type) const;
+
+    /**
+     * @brief Найти свёртку, которую нужно применить в данном состоянии.
+     * @param state Текущее состояние анализатора.
+     * @return Индекс самой длинной свёртки, которой заканчивается стек, если такая есть.
+     */
+    std::optional<size_t> find_convolution(size_t state) const;
+
+    /**
+     * @brief Количество состояний анализатора.
+     */
+    size_t states_count() const;
+
+private:
+    /**
+     * @brief Переход из состояния по типу следующей лексемы.
+     */
+    struct Transition {
+        size_t state{initial_state};
+        bool need_next{false};
+    };
+
+    std::vector<std::array<Transition, lexeme_types_count>> transitions_;
+    std::vector<std::optional<size_t>> reductions_;
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_PARSETABLE_H
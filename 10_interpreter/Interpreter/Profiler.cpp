@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <iomanip>
+
+#include "Profiler.h"
+#include "Convolution.h"
+
+void Profiler::record_rule(const Convolution &convolution, Clock::duration time) {
+    auto found = rule_indexes_.find(&convolution);
+    if (found == rule_indexes_.end()) {
+        found = rule_indexes_.emplace(&convolution, rules_.size()).first;
+        rules_.push_back({convolution.get_from()});
+    }
+    auto &rule = rules_[found->second];
+    rule.hits += 1;
+    rule.time += time;
+}
+
+void Profiler::record_lookup(Clock::duration time) {
+    lookups_ += 1;
+    lookup_time_ += time;
+}
+
+void Profiler::record_depth(size_t depth) {
+    max_depth_ = std::max(max_depth_, depth);
+}
+
+void Profiler::count_tokens(const std::vector<Lexeme> &lexemes) {
+    for (const auto &lexeme: lexemes) {
+        token_counts_[lexeme.get_type()] += 1;
+    }
+}
+
+void Profiler::merge(const Profiler &other) {
+    // свёртки добавляются в порядке их первого применения в other
+    std::vector<const Convolution *> convolutions(other.rules_.size());
+    for (const auto &[convolution, index]: other.rule_indexes_) {
+        convolutions[index] = convolution;
+    }
+    for (size_t i = 0; i < convolutions.size(); ++i) {
+        auto found = rule_indexes_.find(convolutions[i]);
+        if (found == rule_indexes_.end()) {
+            found = rule_indexes_.emplace(convolutions[i], rules_.size()).first;
+            rules_.push_back({other.rules_[i].from});
+        }
+        auto &rule = rules_[found->second];
+        rule.hits += other.rules_[i].hits;
+        rule.time += other.rules_[i].time;
+    }
+    lookups_ += other.lookups_;
+    lookup_time_ += other.lookup_time_;
+    max_depth_ = std::max(max_depth_, other.max_depth_);
+    for (size_t type = 0; type < lexeme_types_count; ++type) {
+        token_counts_[type] += other.token_counts_[type];
+    }
+}
+
+const std::vector<Profiler::RuleStatistics> &Profiler::get_rules() const {
+    return rules_;
+}
+
+size_t Profiler::get_lookups() const {
+    return lookups_;
+}
+
+Profiler::Clock::duration Profiler::get_lookup_time() const {
+    return lookup_time_;
+}
+
+size_t Profiler::get_max_depth() const {
+    return max_depth_;
+}
+
+size_t Profiler::get_token_count(Lexeme::LexemeType type) const {
+    return token_counts_[type];
+}
+
+void Profiler::print_report(std::ostream &out) const {
+    using std::chrono::microseconds;
+    using std::chrono::duration_cast;
+
+    out << "Convolutions:" << std::endl;
+    out << std::setw(10) << "hits" << std::setw(14) << "time, us" << "  rule" << std::endl;
+    for (auto index: sorted_rules()) {
+        const auto &rule = rules_[index];
+        out << std::setw(10) << rule.hits
+            << std::setw(14) << duration_cast<microseconds>(rule.time).count()
+            << "  " << rule_to_string(rule.from) << std::endl;
+    }
+    out << "Convolution lookups: " << lookups_
+        << ", time, us: " << duration_cast<microseconds>(lookup_time_).count() << std::endl;
+    out << "Max parser stack depth: " << max_depth_ << std::endl;
+    out << "Tokens:" << std::endl;
+    for (size_t type = 0; type < lexeme_types_count; ++type) {
+        if (token_counts_[type] > 0) {
+            out << std::setw(10) << token_counts_[type] << "  "
+                << Lexeme::LexemeTypeToString(static_cast<Lexeme::LexemeType>(type)) << std::endl;
+        }
+    }
+}
+
+void Profiler::print_json(std::ostream &out) const {
+    using std::chrono::nanoseconds;
+    using std::chrono::duration_cast;
+
+    out << "{\"convolutions\": [";
+    bool first = true;
+    for (auto index: sorted_rules()) {
+        const auto &rule = rules_[index];
+        out << (first ? "" : ", ")
+            << "{\"rule\": \"" << rule_to_string(rule.from) << "\", "
+            << "\"hits\": " << rule.hits << ", "
+            << "\"time_ns\": " << duration_cast<nanoseconds>(rule.time).count() << "}";
+        first = false;
+    }
+    out << "], \"lookups\": " << lookups_
+        << ", \"lookup_time_ns\": " << duration_cast<nanoseconds>(lookup_time_).count()
+        << ", \"max_stack_depth\": " << max_depth_
+        << ", \"tokens\": {";
+    first = true;
+    for (size_t type = 0; type < lexeme_types_count; ++type) {
+        if (token_counts_[type] > 0) {
+            out << (first ? "" : ", ")
+                << "\"" << Lexeme::LexemeTypeToString(static_cast<Lexeme::LexemeType>(type)) << "\": "
+                << token_counts_[type];
+            first = false;
+        }
+    }
+    out << "}}" << std::endl;
+}
+
+std::vector<size_t> Profiler::sorted_rules() const {
+    std::vector<size_t> indexes(rules_.size());
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        indexes[i] = i;
+    }
+    std::stable_sort(indexes.begin(), indexes.end(), [this](size_t lhs, size_t rhs) {
+        return rules_[lhs].hits > rules_[rhs].hits;
+    });
+    return indexes;
+}
+
+std::string Profiler::rule_to_string(const std::vector<Lexeme::LexemeType> &from) {
+    std::string result;
+    for (auto type: from) {
+        if (!result.empty()) {
+            result += " ";
+        }
+        result += Lexeme::LexemeTypeToString(type);
+    }
+    return result;
+}
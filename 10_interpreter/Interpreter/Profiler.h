@@ -0,0 +1,110 @@
+#ifndef MADEALGORITHMSHOMEWORK2_PROFILER_H
+#define MADEALGORITHMSHOMEWORK2_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Lexeme.h"
+
+class Convolution;
+
+/**
+ * @brief Сбор статистики работы интерпретатора: какие свёртки срабатывают, сколько времени они занимают,
+ * какой глубины достигает стек анализатора и сколько лексем каждого типа прочитано.
+ * @details Профилирование включается передачей профилировщика в Syntaxer. Без него анализатор не делает лишней работы.
+ */
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Статистика одной свёртки.
+     */
+    struct RuleStatistics {
+        std::vector<Lexeme::LexemeType> from;   // последовательность лексем, которую сворачивает свёртка
+        size_t hits{0};                         // сколько раз свёртка была применена
+        Clock::duration time{0};                // суммарное время применения свёртки
+    };
+
+    Profiler() = default;
+
+    /**
+     * @brief Учесть одно применение свёртки.
+     * @param convolution Применённая свёртка.
+     * @param time Время применения.
+     */
+    void record_rule(const Convolution &convolution, Clock::duration time);
+
+    /**
+     * @brief Учесть один поиск свёртки в таблице переходов.
+     * @param time Время поиска.
+     */
+    void record_lookup(Clock::duration time);
+
+    /**
+     * @brief Учесть текущую глубину стека анализатора.
+     * @param depth Количество лексем в стеке.
+     */
+    void record_depth(size_t depth);
+
+    /**
+     * @brief Посчитать лексемы, полученные лексическим анализатором, по типам.
+     * @param lexemes Лексемы.
+     */
+    void count_tokens(const std::vector<Lexeme> &lexemes);
+
+    /**
+     * @brief Добавить статистику другого профилировщика, например собранную в другом потоке.
+     * @param other Профилировщик, статистика которого добавляется.
+     */
+    void merge(const Profiler &other);
+
+    // методы для получения собранной статистики
+    const std::vector<RuleStatistics> &get_rules() const;
+    size_t get_lookups() const;
+    Clock::duration get_lookup_time() const;
+    size_t get_max_depth() const;
+    size_t get_token_count(Lexeme::LexemeType type) const;
+
+    /**
+     * @brief Вывести отчёт в виде таблицы. Свёртки упорядочены по убыванию количества применений.
+     * @param out Поток вывода.
+     */
+    void print_report(std::ostream &out) const;
+
+    /**
+     * @brief Вывести отчёт в формате JSON.
+     * @param out Поток вывода.
+     */
+    void print_json(std::ostream &out) const;
+
+private:
+    static constexpr size_t lexeme_types_count = Lexeme::LexemeType::LIST + 1;
+
+    std::vector<RuleStatistics> rules_;
+    std::unordered_map<const Convolution *, size_t> rule_indexes_;
+    size_t lookups_{0};
+    Clock::duration lookup_time_{0};
+    size_t max_depth_{0};
+    std::array<size_t, lexeme_types_count> token_counts_{};
+
+    /**
+     * @brief Свёртки, упорядоченные по убыванию количества применений.
+     * @return Индексы свёрток в rules_.
+     */
+    std::vector<size_t> sorted_rules() const;
+
+    /**
+     * @brief Символьное представление последовательности лексем, которую сворачивает свёртка.
+     * @param from Последовательность типов лексем.
+     * @return Типы лексем через пробел.
+     */
+    static std::string rule_to_string(const std::vector<Lexeme::LexemeType> &from);
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_PROFILER_H
@@ -0,0 +1,106 @@
+#include <iostream>
+
+#include "Program.h"
+
+void Program::emit(Program::OpCode code, uint32_t operand, uint32_t action) {
+    code_.push_back({code, operand, action});
+}
+
+uint32_t Program::add_lexeme(const Lexeme &lexeme) {
+    lexemes_.push_back(lexeme);
+    return static_cast<uint32_t>(lexemes_.size() - 1);
+}
+
+uint32_t Program::add_action(const Lexeme &lexeme) {
+    auto found = action_indexes_.find(lexeme.get_code());
+    if (found != action_indexes_.end()) {
+        return found->second;
+    }
+    auto index = add_lexeme(lexeme);
+    action_indexes_[lexeme.get_code()] = index;
+    return index;
+}
+
+uint32_t Program::add_name(const std::string &name) {
+    auto found = name_indexes_.find(name);
+    if (found != name_indexes_.end()) {
+        return found->second;
+    }
+    names_.push_back(name);
+    auto index = static_cast<uint32_t>(names_.size() - 1);
+    name_indexes_[name] = index;
+    return index;
+}
+
+const std::vector<Program::Instruction> &Program::get_code() const {
+    return code_;
+}
+
+const std::vector<Lexeme> &Program::get_lexemes() const {
+    return lexemes_;
+}
+
+const std::vector<std::string> &Program::get_names() const {
+    return names_;
+}
+
+void Program::set_code(std::vector<Instruction> code) {
+    code_ = std::move(code);
+}
+
+void Program::debug_print() const {
+    std::cerr << "Program of " << code_.size() << " instructions: " << std::endl;
+    for (const auto &instruction: code_) {
+        std::cerr << "\t" << OpCodeToString(instruction.code);
+        switch (instruction.code) {
+            case PUSH:
+                std::cerr << " " << lexemes_[instruction.operand].get_code();
+                break;
+            case LOAD:
+            case STORE:
+            case LOAD_ELEMENT:
+            case STORE_ELEMENT:
+            case ECHO:
+                std::cerr << " " << names_[instruction.operand];
+                break;
+            case BINARY:
+            case UNARY:
+                std::cerr << " " << lexemes_[instruction.action].get_code();
+                break;
+            default:
+                break;
+        }
+        std::cerr << std::endl;
+    }
+}
+
+std::string Program::OpCodeToString(Program::OpCode code) {
+    switch (code) {
+        case PUSH:
+            return "PUSH";
+        case LOAD:
+            return "LOAD";
+        case STORE:
+            return "STORE";
+        case LOAD_ELEMENT:
+            return "LOAD_ELEMENT";
+        case STORE_ELEMENT:
+            return "STORE_ELEMENT";
+        case BINARY:
+            return "BINARY";
+        case UNARY:
+            return "UNARY";
+        case MAKE_LIST:
+            return "MAKE_LIST";
+        case APPEND_LIST:
+            return "APPEND_LIST";
+        case POP:
+            return "POP";
+        case DUP:
+            return "DUP";
+        case ECHO:
+            return "ECHO";
+        default:
+            return "Unknown instruction";
+    }
+}
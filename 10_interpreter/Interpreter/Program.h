@@ -0,0 +1,107 @@
+#ifndef MADEALGORITHMSHOMEWORK2_PROGRAM_H
+#define MADEALGORITHMSHOMEWORK2_PROGRAM_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Lexeme.h"
+
+/**
+ * @brief Скомпилированная программа: последовательность инструкций стековой машины.
+ * @details Программа получается один раз из кода и затем может выполняться многократно
+ * без лексического и синтаксического анализа.
+ */
+class Program {
+public:
+    /**
+     * @brief Коды инструкций стековой машины.
+     */
+    enum OpCode {
+        PUSH,           // положить в стек константу lexemes[operand]
+        LOAD,           // положить в стек значение переменной names[operand]
+        STORE,          // снять значение со стека и присвоить переменной names[operand] действием lexemes[action]
+        LOAD_ELEMENT,   // снять индекс со стека и положить элемент массива names[operand]
+        STORE_ELEMENT,  // снять значение и индекс со стека и записать элемент массива names[operand]
+        BINARY,         // снять два значения со стека и положить результат действия lexemes[action]
+        UNARY,          // снять значение со стека и положить результат действия lexemes[action] (функции и отрицание)
+        MAKE_LIST,      // превратить значение на вершине стека в массив из одного элемента
+        APPEND_LIST,    // снять значение со стека и добавить его в массив на вершине стека
+        POP,            // снять значение со стека
+        DUP,            // положить в стек копию значения на вершине стека
+        ECHO            // снять значение со стека и напечатать его как присваивание names[operand], не сохраняя
+    };
+
+    /**
+     * @brief Инструкция стековой машины.
+     */
+    struct Instruction {
+        OpCode code;
+        uint32_t operand{0};
+        uint32_t action{0};
+    };
+
+    Program() = default;
+
+    /**
+     * @brief Добавить инструкцию в конец программы.
+     * @param code Код инструкции.
+     * @param operand Индекс константы или имени переменной.
+     * @param action Индекс лексемы, содержащей действие.
+     */
+    void emit(OpCode code, uint32_t operand = 0, uint32_t action = 0);
+
+    /**
+     * @brief Добавить лексему (константу или действие) в программу.
+     * @param lexeme Лексема.
+     * @return Индекс лексемы в программе.
+     */
+    uint32_t add_lexeme(const Lexeme &lexeme);
+
+    /**
+     * @brief Добавить лексему, содержащую действие, в программу. Одинаковые действия получают один и тот же индекс.
+     * @param lexeme Лексема, содержащая действие (оператор или функцию).
+     * @return Индекс лексемы в программе.
+     */
+    uint32_t add_action(const Lexeme &lexeme);
+
+    /**
+     * @brief Добавить имя переменной в программу. Одинаковые имена получают один и тот же индекс.
+     * @param name Имя переменной.
+     * @return Индекс имени в программе.
+     */
+    uint32_t add_name(const std::string &name);
+
+    // методы для получения содержимого программы
+    const std::vector<Instruction> &get_code() const;
+    const std::vector<Lexeme> &get_lexemes() const;
+    const std::vector<std::string> &get_names() const;
+
+    /**
+     * @brief Заменить инструкции программы, например, после оптимизации.
+     * @param code Новые инструкции. Индексы лексем и имён должны ссылаться на эту же программу.
+     */
+    void set_code(std::vector<Instruction> code);
+
+    /**
+     * @brief Печать инструкций программы для отладки.
+     */
+    void debug_print() const;
+
+    /**
+     * @brief Получить название инструкции для вывода сообщения на экран.
+     * @param code Код инструкции.
+     * @return Название инструкции.
+     */
+    static std::string OpCodeToString(OpCode code);
+
+private:
+    std::vector<Instruction> code_;
+    std::vector<Lexeme> lexemes_;
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, uint32_t> name_indexes_;
+    std::unordered_map<std::string, uint32_t> action_indexes_;
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_PROGRAM_H
@@ -0,0 +1,67 @@
+#include <fstream>
+#include <sstream>
+
+#include "SourceFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define INTERPRETER_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SourceFile::SourceFile(const std::string &path) {
+#ifdef INTERPRETER_USE_MMAP
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor >= 0) {
+        struct stat info{};
+        if ((fstat(descriptor, &info) == 0) && S_ISREG(info.st_mode)) {
+            size_ = static_cast<size_t>(info.st_size);
+            if (size_ == 0) {  // пустой файл отобразить нельзя, но он и не нужен
+                is_open_ = true;
+            } else {
+                void *mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (mapped != MAP_FAILED) {
+                    madvise(mapped, size_, MADV_SEQUENTIAL);
+                    mapped_ = static_cast<const char *>(mapped);
+                    is_open_ = true;
+                }
+            }
+        }
+        close(descriptor);
+        if (is_open_) {
+            return;
+        }
+        size_ = 0;
+    }
+#endif
+    // отображение недоступно (другая ОС, канал вместо файла и т.п.) - читаем файл целиком
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    buffer_ = content.str();
+    is_open_ = true;
+}
+
+SourceFile::~SourceFile() {
+#ifdef INTERPRETER_USE_MMAP
+    if (mapped_ != nullptr) {
+        munmap(const_cast<char *>(mapped_), size_);
+    }
+#endif
+}
+
+bool SourceFile::is_open() const {
+    return is_open_;
+}
+
+std::string_view SourceFile::get_text() const {
+    if (mapped_ != nullptr) {
+        return std::string_view(mapped_, size_);
+    }
+    return buffer_;
+}
@@ -0,0 +1,44 @@
+#ifndef MADEALGORITHMSHOMEWORK2_SOURCEFILE_H
+#define MADEALGORITHMSHOMEWORK2_SOURCEFILE_H
+
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Файл с исходным кодом, целиком доступный в памяти.
+ * @details На POSIX-системах файл отображается в память (mmap) и не копируется,
+ * на остальных - читается в строку одним вызовом.
+ */
+class SourceFile {
+public:
+    /**
+     * @brief Открыть файл.
+     * @param path Путь к файлу.
+     */
+    explicit SourceFile(const std::string &path);
+    ~SourceFile();
+
+    SourceFile(const SourceFile &) = delete;
+    SourceFile &operator=(const SourceFile &) = delete;
+
+    /**
+     * @brief Удалось ли открыть файл.
+     * @return True, если файл открыт, иначе - false.
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Получить содержимое файла.
+     * @return Текст файла. Действителен, пока жив объект.
+     */
+    std::string_view get_text() const;
+
+private:
+    bool is_open_{false};
+    const char *mapped_{nullptr};
+    size_t size_{0};
+    std::string buffer_;
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_SOURCEFILE_H
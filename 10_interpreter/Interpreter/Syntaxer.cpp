@@ -4,20 +4,53 @@
 
 #include "Syntaxer.h"
 
-void Syntaxer::execute(const std::vector<Lexeme> &lexemes_input, Grammar &grammar) {
+void Syntaxer::execute(const std::vector<Lexeme> &lexemes_input, Grammar &grammar, Profiler *profiler) {
+    parse(lexemes_input, grammar, [&grammar](const Convolution &conv, std::vector<Lexeme> &current_state) {
+        conv.apply(current_state, grammar);
+    }, profiler);
+}
+
+Program Syntaxer::compile(const std::vector<Lexeme> &lexemes_input, Grammar &grammar, Profiler *profiler) {
+    Program program;
+    parse(lexemes_input, grammar, [&program](const Convolution &conv, std::vector<Lexeme> &current_state) {
+        conv.compile(current_state, program);
+    }, profiler);
+    return program;
+}
+
+void Syntaxer::parse(const std::vector<Lexeme> &lexemes_input, Grammar &grammar,
+                     const std::function<void(const Convolution &, std::vector<Lexeme> &)> &apply, Profiler *profiler) {
+    /*
+     * Стек анализатора живёт между вызовами: перед разбором он очищается, но память под лексемы и состояния остаётся,
+     * поэтому разбор длинных и глубоко вложенных операторов не выделяет память заново для каждой строки.
+     * У каждого потока свой стек.
+     */
+    thread_local ParserStack stack;
+    auto &current_state = stack.lexemes;
+    // states[i] - состояние анализатора после чтения первых i лексем из current_state
+    auto &states = stack.states;
+    current_state.clear();
+    states.assign(1, ParseTable::initial_state);
     size_t cursor_input = 0;
-    std::vector<Lexeme> current_state;
     while(cursor_input<lexemes_input.size())
     {
-        while ((cursor_input < lexemes_input.size()) && grammar.need_next(current_state, lexemes_input[cursor_input]))
+        while ((cursor_input < lexemes_input.size()) && grammar.need_next(states.back(), lexemes_input[cursor_input]))
         {
             // пока нужно читать следующий символ, читаем его
             current_state.push_back(lexemes_input[cursor_input]);
+            states.push_back(grammar.next_state(states.back(), lexemes_input[cursor_input]));
             cursor_input += 1;
         }
+        if (profiler != nullptr) {
+            profiler->record_depth(current_state.size());
+        }
         // производим свёртку
-        auto conv = grammar.find_convolution(current_state);
-        if (!conv.has_value()){
+        auto lookup_start = (profiler != nullptr) ? Profiler::Clock::now() : Profiler::Clock::time_point();
+        auto conv = grammar.find_convolution(states.back());
+        if (profiler != nullptr) {
+            profiler->record_lookup(Profiler::Clock::now() - lookup_start);
+        }
+        if (conv == nullptr){
             std::cerr << "No suitable convolution was found for ";
             for(const auto& lexeme: current_state){
                 std::cerr << Lexeme::LexemeTypeToString(lexeme.get_type()) << " ";
@@ -25,7 +58,20 @@ void Syntaxer::execute(const std::vector<Lexeme> &lexemes_input, Grammar &gramma
             std::cerr << std::endl;
             break;
         } else {
-            conv.value().apply(current_state, grammar);
+            size_t untouched = current_state.size() - conv->size();
+            if (profiler != nullptr) {
+                auto apply_start = Profiler::Clock::now();
+                apply(*conv, current_state);
+                profiler->record_rule(*conv, Profiler::Clock::now() - apply_start);
+            } else {
+                apply(*conv, current_state);
+            }
+            // свёртка меняет только конец стека, пересчитываем состояния лишь для него
+            untouched = std::min(untouched, current_state.size());
+            states.resize(untouched + 1);
+            for (size_t i = untouched; i < current_state.size(); ++i) {
+                states.push_back(grammar.next_state(states.back(), current_state[i]));
+            }
         }
     }
 }
@@ -1,5 +1,7 @@
 #include "Grammar.h"
 #include "Lexeme.h"
+#include "Program.h"
+#include "Profiler.h"
 
 #ifndef MADEALGORITHMSHOMEWORK2_SYNTAXER_H
 #define MADEALGORITHMSHOMEWORK2_SYNTAXER_H
@@ -16,9 +18,38 @@ public:
      * @brief Произвести разбор входной последовательности лексем.
      * @param lexemes_input Входные лексемы.
      * @param grammar Грамматика языка.
+     * @param profiler Профилировщик, в который записывается статистика разбора, или nullptr.
      */
-    static void execute(const std::vector<Lexeme>& lexemes_input, Grammar& grammar);
+    static void execute(const std::vector<Lexeme>& lexemes_input, Grammar& grammar, Profiler *profiler = nullptr);
+
+    /**
+     * @brief Скомпилировать входную последовательность лексем в программу для стековой машины.
+     * @details Разбор выполняется так же, как в execute, но вместо вычислений генерируются инструкции.
+     * Полученную программу можно выполнить многократно с помощью VirtualMachine.
+     * @param lexemes_input Входные лексемы.
+     * @param grammar Грамматика языка.
+     * @param profiler Профилировщик, в который записывается статистика разбора, или nullptr.
+     * @return Скомпилированная программа.
+     */
+    static Program compile(const std::vector<Lexeme>& lexemes_input, Grammar& grammar, Profiler *profiler = nullptr);
 private:
+    /**
+     * @brief Стек синтаксического анализатора: лексемы и состояния после чтения каждой из них.
+     */
+    struct ParserStack {
+        std::vector<Lexeme> lexemes;
+        std::vector<size_t> states;
+    };
+
+    /**
+     * @brief Общий для исполнения и компиляции разбор входной последовательности лексем.
+     * @param lexemes_input Входные лексемы.
+     * @param grammar Грамматика языка.
+     * @param apply Применение найденной свёртки к стеку лексем.
+     * @param profiler Профилировщик, в который записывается статистика разбора, или nullptr.
+     */
+    static void parse(const std::vector<Lexeme>& lexemes_input, Grammar& grammar,
+                      const std::function<void(const Convolution &, std::vector<Lexeme> &)> &apply, Profiler *profiler);
 };
 
 
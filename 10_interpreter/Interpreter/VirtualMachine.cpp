@@ -0,0 +1,101 @@
+#include "VirtualMachine.h"
+
+/**
+ * @brief Завершает ли инструкция оператор программы.
+ * @details После такой инструкции стек машины пуст.
+ */
+static bool ends_statement(Program::OpCode code) {
+    return (code == Program::OpCode::STORE) || (code == Program::OpCode::ECHO) ||
+           (code == Program::OpCode::STORE_ELEMENT) || (code == Program::OpCode::POP);
+}
+
+void VirtualMachine::run(const Program &program, Grammar &grammar) {
+    const auto &lexemes = program.get_lexemes();
+    const auto &names = program.get_names();
+    auto &variables = grammar.get_environment();
+    // slots[i] - ячейка таблицы переменных для имени names[i]
+    std::vector<uint32_t> slots;
+    slots.reserve(names.size());
+    for (const auto &name: names) {
+        slots.push_back(variables.resolve(name));
+    }
+    std::vector<Lexeme> stack;
+    // оператор, в котором произошла ошибка, пропускается до конца, остальные выполняются как обычно
+    bool is_skipping = false;
+    for (const auto &instruction: program.get_code()) {
+        if (is_skipping) {
+            if (ends_statement(instruction.code)) {
+                stack.clear();
+                is_skipping = false;
+            }
+            continue;
+        }
+        switch (instruction.code) {
+            case Program::OpCode::PUSH:
+                stack.push_back(lexemes[instruction.operand]);
+                break;
+            case Program::OpCode::LOAD:
+                stack.push_back(variables.at(slots[instruction.operand]));
+                break;
+            case Program::OpCode::STORE: {
+                auto slot = slots[instruction.operand];
+                lexemes[instruction.action].exec_action(variables.at(slot), stack.back());
+                stack.pop_back();
+                variables.define(slot);
+                break;
+            }
+            case Program::OpCode::ECHO: {
+                // значение всё равно будет перезаписано, поэтому его не нужно сохранять, только напечатать
+                auto variable = Lexeme(Lexeme::LexemeType::IDENTIFIER, names[instruction.operand]);
+                lexemes[instruction.action].exec_action(variable, stack.back());
+                stack.pop_back();
+                break;
+            }
+            case Program::OpCode::LOAD_ELEMENT: {
+                auto result = variables.at(slots[instruction.operand]).get_element(stack.back());
+                stack.pop_back();
+                if (!result.has_value()) {
+                    is_skipping = true;
+                    break;
+                }
+                stack.push_back(result.value());
+                break;
+            }
+            case Program::OpCode::STORE_ELEMENT: {
+                auto &array = variables.at(slots[instruction.operand]);
+                bool is_set = array.set_element(*(stack.end() - 2), stack.back());
+                stack.erase(stack.end() - 2, stack.end());
+                if (is_set) {
+                    array.print();
+                }
+                break;
+            }
+            case Program::OpCode::BINARY: {
+                auto result = lexemes[instruction.action].exec_action(*(stack.end() - 2), stack.back());
+                stack.erase(stack.end() - 2, stack.end());
+                stack.push_back(result);
+                break;
+            }
+            case Program::OpCode::UNARY: {
+                auto dummy = Lexeme();
+                stack.back() = lexemes[instruction.action].exec_action(stack.back(), dummy);
+                break;
+            }
+            case Program::OpCode::MAKE_LIST:
+                stack.back().wrap_into_array();
+                break;
+            case Program::OpCode::APPEND_LIST: {
+                auto element = stack.back();
+                stack.pop_back();
+                stack.back().push_back_element(element);
+                break;
+            }
+            case Program::OpCode::POP:
+                stack.pop_back();
+                break;
+            case Program::OpCode::DUP:
+                stack.push_back(stack.back());
+                break;
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef MADEALGORITHMSHOMEWORK2_VIRTUALMACHINE_H
+#define MADEALGORITHMSHOMEWORK2_VIRTUALMACHINE_H
+
+#include <vector>
+
+#include "Grammar.h"
+#include "Lexeme.h"
+#include "Program.h"
+
+/**
+ * @brief Стековая машина, выполняющая скомпилированные программы.
+ * @details Перед выполнением имена переменных программы один раз сопоставляются ячейкам таблицы переменных грамматики,
+ * далее инструкции обращаются к ячейкам по номеру. Значения читаются в момент выполнения инструкции,
+ * поэтому одну и ту же программу можно выполнять многократно с разными значениями переменных.
+ * @details Если элемент массива прочитать не удалось, оставшаяся часть оператора пропускается
+ * и выполнение продолжается со следующего оператора, как при ошибке записи элемента.
+ */
+class VirtualMachine {
+public:
+    VirtualMachine() = default;
+    ~VirtualMachine() = default;
+
+    /**
+     * @brief Выполнить программу.
+     * @param program Скомпилированная программа.
+     * @param grammar Грамматика языка, в которой хранятся переменные.
+     */
+    static void run(const Program &program, Grammar &grammar);
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_VIRTUALMACHINE_H
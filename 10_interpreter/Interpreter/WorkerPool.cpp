@@ -0,0 +1,70 @@
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "WorkerPool.h"
+#include "Grammar.h"
+#include "Lexer.h"
+#include "Syntaxer.h"
+#include "Optimizer.h"
+#include "VirtualMachine.h"
+
+std::vector<WorkerPool::Result> WorkerPool::run(const std::vector<std::string> &scripts, size_t threads_count,
+                                                const std::shared_ptr<const Language> &language, Profiler *profiler) {
+    if (threads_count == 0) {
+        threads_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads_count = std::min(threads_count, scripts.size());
+
+    // каждый поток берёт следующий ещё не выполненный сценарий, поэтому длинные сценарии не задерживают остальные
+    std::vector<Result> results(scripts.size());
+    std::atomic<size_t> next{0};
+    std::vector<Profiler> profilers(threads_count);
+    auto worker = [&](size_t thread_index) {
+        auto *thread_profiler = (profiler != nullptr) ? &profilers[thread_index] : nullptr;
+        for (auto index = next++; index < scripts.size(); index = next++) {
+            results[index] = run_script(scripts[index], language, thread_profiler);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threads_count);
+    for (size_t i = 0; i < threads_count; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    if (profiler != nullptr) {
+        for (const auto &thread_profiler: profilers) {
+            profiler->merge(thread_profiler);
+        }
+    }
+    return results;
+}
+
+WorkerPool::Result WorkerPool::run_script(const std::string &script, const std::shared_ptr<const Language> &language,
+                                          Profiler *profiler) {
+    Result result;
+    std::ostringstream output;
+    auto &previous_output = Lexeme::get_output();
+    Lexeme::set_output(output);
+    try {
+        Grammar grammar(language);
+        auto lexemes = Lexer::parse_code(script, grammar);
+        if (profiler != nullptr) {
+            profiler->count_tokens(lexemes);
+        }
+        auto program = Syntaxer::compile(lexemes, grammar, profiler);
+        Optimizer::optimize(program, grammar);
+        VirtualMachine::run(program, grammar);
+        result.success = true;
+    } catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        result.success = false;
+    }
+    Lexeme::set_output(previous_output);
+    result.output = output.str();
+    return result;
+}
@@ -0,0 +1,54 @@
+#ifndef MADEALGORITHMSHOMEWORK2_WORKERPOOL_H
+#define MADEALGORITHMSHOMEWORK2_WORKERPOOL_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Language.h"
+#include "Profiler.h"
+
+/**
+ * @brief Параллельное выполнение независимых сценариев над одним общим языком.
+ * @details Каждый сценарий выполняется в собственном сеансе (класс Grammar) со своими переменными,
+ * а неизменяемый язык (класс Language) разделяется между всеми потоками.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Результат выполнения одного сценария.
+     */
+    struct Result {
+        std::string output;     // всё, что сценарий напечатал
+        bool success{false};    // false, если выполнение прервано исключением
+    };
+
+    WorkerPool() = default;
+    ~WorkerPool() = default;
+
+    /**
+     * @brief Выполнить сценарии параллельно.
+     * @param scripts Тексты сценариев.
+     * @param threads_count Количество потоков. Если 0, используется количество ядер.
+     * @param language Язык, общий для всех сценариев.
+     * @param profiler Профилировщик или nullptr, если профилирование выключено.
+     * Каждый поток собирает статистику отдельно, после завершения потоков она суммируется в profiler.
+     * @return Результаты в том же порядке, что и сценарии.
+     */
+    static std::vector<Result> run(const std::vector<std::string> &scripts, size_t threads_count = 0,
+                                   const std::shared_ptr<const Language> &language = Language::get_shared(),
+                                   Profiler *profiler = nullptr);
+
+    /**
+     * @brief Выполнить один сценарий в новом сеансе.
+     * @param script Текст сценария.
+     * @param language Язык.
+     * @param profiler Профилировщик или nullptr, если профилирование выключено.
+     * @return Результат выполнения.
+     */
+    static Result run_script(const std::string &script, const std::shared_ptr<const Language> &language,
+                             Profiler *profiler = nullptr);
+};
+
+
+#endif //MADEALGORITHMSHOMEWORK2_WORKERPOOL_H
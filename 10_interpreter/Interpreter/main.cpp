@@ -1,36 +1,180 @@
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <vector>
 
 #include "Grammar.h"
 #include "Lexer.h"
 #include "Syntaxer.h"
+#include "VirtualMachine.h"
+#include "Optimizer.h"
+#include "SourceFile.h"
+#include "Profiler.h"
+#include "WorkerPool.h"
 
-int main(int argc, char *argv[]) {
-    std::ios::sync_with_stdio(false);
-    std::cin.tie(nullptr);
-    std::cout.tie(nullptr);
+/**
+ * @brief Выполнить код целиком: один проход лексического анализатора по всему тексту,
+ * затем компиляция и выполнение всех операторов.
+ * @param code Код программы.
+ * @param grammar Грамматика языка.
+ * @param profiler Профилировщик или nullptr, если профилирование выключено.
+ * @return Код возврата программы.
+ */
+static int execute_batch(std::string_view code, Grammar &grammar, Profiler *profiler) {
+    try {
+        auto lexemes = Lexer::parse_code(code, grammar);
+        if (profiler != nullptr) {
+            profiler->count_tokens(lexemes);
+        }
+        auto program = Syntaxer::compile(lexemes, grammar, profiler);
+        Optimizer::optimize(program, grammar);
+        VirtualMachine::run(program, grammar);
+    } catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
 
-    Grammar grammar;
+/**
+ * @brief Выполнять код построчно со стандартного ввода, пока не будет введено "exit;".
+ * @param grammar Грамматика языка.
+ * @param profiler Профилировщик или nullptr, если профилирование выключено.
+ * @return Код возврата программы.
+ */
+static int execute_interactive(Grammar &grammar, Profiler *profiler) {
+    std::string command;
+    while(getline(std::cin, command))
+    {
+        if (command == "exit;") {
+            break;
+        }
+        try {
+            auto lexemes = Lexer::parse_code(command, grammar);
+            if (profiler != nullptr) {
+                profiler->count_tokens(lexemes);
+            }
+            auto program = Syntaxer::compile(lexemes, grammar, profiler);
+            Optimizer::optimize(program, grammar);
+            VirtualMachine::run(program, grammar);
+        } catch (const std::exception &exception) {
+            // ошибка в строке не завершает сеанс, выполняется следующая строка
+            std::cerr << exception.what() << std::endl;
+        }
+    }
+    return 0;
+}
 
-    if (argc > 1) {
-        if (std::string(argv[1]) == "-c")
+/**
+ * @brief Выбрать режим работы по аргументам командной строки и выполнить код.
+ * @param argc Количество аргументов, оставшихся после ключей профилирования.
+ * @param argv Аргументы, оставшиеся после ключей профилирования.
+ * @param program_name Имя исполняемого файла для сообщений.
+ * @param grammar Грамматика языка.
+ * @param profiler Профилировщик или nullptr, если профилирование выключено.
+ * @return Код возврата программы.
+ */
+static int execute(int argc, char *argv[], const char *program_name, Grammar &grammar, Profiler *profiler) {
+    if (argc > 0) {
+        if (std::string(argv[0]) == "-c")
         {
-            return 0;
+            if (argc < 2) {
+                std::cerr << "Usage: " << program_name << " -c \"code\"" << std::endl;
+                return 1;
+            }
+            return execute_batch(argv[1], grammar, profiler);
         }
 
-        if (std::string(argv[1]) == "-f")
+        if (std::string(argv[0]) == "-f")
         {
-            return 0;
+            if (argc < 2) {
+                std::cerr << "Usage: " << program_name << " -f script_file" << std::endl;
+                return 1;
+            }
+            SourceFile file(argv[1]);
+            if (!file.is_open()) {
+                std::cerr << "Cannot open file: " << argv[1] << std::endl;
+                return 1;
+            }
+            return execute_batch(file.get_text(), grammar, profiler);
         }
     }
+    return execute_interactive(grammar, profiler);
+}
 
-    std::string command;
-    while(getline(std::cin, command))
-    {
-        if (command == "exit;") {
-            break;
+/**
+ * @brief Выполнить несколько файлов со сценариями параллельно, каждый в своём сеансе.
+ * @details Вывод сценариев печатается целиком в порядке файлов.
+ * @param argc Количество аргументов после ключа -j.
+ * @param argv Аргументы после ключа -j: количество потоков и имена файлов.
+ * @param program_name Имя исполняемого файла для сообщений.
+ * @param profiler Профилировщик или nullptr, если профилирование выключено.
+ * @return Код возврата программы.
+ */
+static int execute_parallel(int argc, char *argv[], const char *program_name, Profiler *profiler) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << program_name << " -j threads_count script_file..." << std::endl;
+        return 1;
+    }
+    size_t threads_count = 0;
+    try {
+        threads_count = std::stoul(argv[0]);
+    } catch (const std::exception &exception) {
+        std::cerr << "Invalid threads count: " << argv[0] << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> scripts;
+    for (int i = 1; i < argc; ++i) {
+        SourceFile file(argv[i]);
+        if (!file.is_open()) {
+            std::cerr << "Cannot open file: " << argv[i] << std::endl;
+            return 1;
         }
-        auto lexemes = Lexer::parse_code(command, grammar);
-        Syntaxer::execute(lexemes, grammar);
+        scripts.emplace_back(file.get_text());
+    }
+
+    int code = 0;
+    for (const auto &result: WorkerPool::run(scripts, threads_count, Language::get_shared(), profiler)) {
+        std::cout << result.output;
+        if (!result.success) {
+            code = 1;
+        }
+    }
+    return code;
+}
+
+int main(int argc, char *argv[]) {
+    // ключи профилирования идут перед остальными аргументами, отчёт печатается в stderr при выходе
+    Profiler profiler;
+    bool profile = false;
+    bool profile_json = false;
+    int first = 1;
+    if (argc > 1 && std::string(argv[1]) == "--profile") {
+        profile = true;
+        first = 2;
+    } else if (argc > 1 && std::string(argv[1]) == "--profile-json") {
+        profile = profile_json = true;
+        first = 2;
+    }
+
+    int code = 0;
+    if (argc > first && std::string(argv[first]) == "-j") {
+        // сообщения об ошибках печатаются из нескольких потоков, поэтому потоки ввода-вывода остаются синхронизированными
+        code = execute_parallel(argc - first - 1, argv + first + 1, argv[0], profile ? &profiler : nullptr);
+    } else {
+        std::ios::sync_with_stdio(false);
+        std::cin.tie(nullptr);
+        std::cout.tie(nullptr);
+
+        Grammar grammar;
+        code = execute(argc - first, argv + first, argv[0], grammar, profile ? &profiler : nullptr);
+    }
+
+    if (profile_json) {
+        profiler.print_json(std::cerr);
+    } else if (profile) {
+        profiler.print_report(std::cerr);
     }
-}
\ No newline at end of file
+    return code;
+}
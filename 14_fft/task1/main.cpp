@@ -60,6 +60,16 @@
 #include <numeric>
 #include <cctype>
 #include <utility>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <cstdint>
+#include <sstream>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 
 /**
@@ -75,407 +85,1959 @@ bool is_equal(FloatType lhs, FloatType rhs, FloatType eps=1e-6) {
     return std::abs(lhs - rhs) < eps;
 }
 
+/**
+ * @brief Теоретико-числовое преобразование (NTT). Просто namespace с private-методами.
+ * @details Аналог преобразования Фурье в кольце вычетов по простому модулю вида c * 2^k + 1:
+ * вместо комплексных корней из единицы используются первообразные корни по модулю.
+ * Все вычисления целочисленные, поэтому свёртка получается точной, а не округлённой.
+ * Подробнее: https://cp-algorithms.com/algebra/fft.html#number-theoretic-transform
+ */
+class ntt {
+public:
+    /**
+     * @brief Выполнить теоретико-числовое преобразование на месте.
+     * @tparam Modulus Простой модуль вида c * 2^k + 1.
+     * @tparam Root Первообразный корень по модулю Modulus.
+     * @param values Вычеты. Длина - степень двойки, не больше 2^k.
+     * @param inverse True, если обратное преобразование, false - прямое.
+     */
+    template<uint32_t Modulus, uint32_t Root>
+    static void transform(std::vector<uint32_t> &values, bool inverse = false);
+
+    /**
+     * @brief Произвести точную свёртку двух целочисленных сигналов.
+     * @details Если коэффициенты свёртки заведомо меньше половины модуля, достаточно одного преобразования.
+     * Иначе свёртка вычисляется по трём модулям и восстанавливается по китайской теореме об остатках,
+     * что даёт точный результат для любых коэффициентов, помещающихся в 64 бита.
+     * @tparam InputType Целочисленный тип данных отсчётов входных сигналов.
+     * @tparam OutputIntegerType Целочисленный тип данных отсчётов свёртки.
+     * @param lhs Первая последовательность.
+     * @param rhs Вторая последовательность.
+     * @return Результат свёртки.
+     */
+    template<typename InputType, typename OutputIntegerType>
+    static std::vector<OutputIntegerType>
+    convolution(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs);
+
+    // Простой модуль для вычислений в поле вычетов: 119 * 2^23 + 1
+    static constexpr uint32_t prime = 998244353;
+
+    /**
+     * @brief Свёртка по модулю prime.
+     * @details В отличие от convolution, коэффициенты свёртки могут быть сколь угодно большими: результат - их вычеты.
+     * @param lhs Первая последовательность.
+     * @param rhs Вторая последовательность.
+     * @return Вычеты коэффициентов свёртки, от 0 до prime - 1.
+     */
+    template<typename InputType>
+    static std::vector<int64_t> convolution_prime(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs);
+
+    /**
+     * @brief Возведение в степень по модулю.
+     * @param base Основание.
+     * @param exponent Показатель степени.
+     * @param modulus Модуль.
+     * @return base^exponent mod modulus.
+     */
+    static uint32_t power(uint32_t base, uint64_t exponent, uint32_t modulus);
+
+private:
+    ntt() = default;  // запретим создание экзампляров класса
+
+    // модули вида c * 2^k + 1, для всех первообразный корень равен 3
+    static constexpr uint32_t modulus1 = prime;  // 119 * 2^23 + 1
+    static constexpr uint32_t modulus2 = 167772161;  // 5 * 2^25 + 1
+    static constexpr uint32_t modulus3 = 469762049;  // 7 * 2^26 + 1
+    static constexpr size_t max_length = static_cast<size_t>(1) << 23;  // ограничение первого модуля
+
+    /**
+     * @brief Свёртка по одному модулю.
+     * @tparam Modulus Простой модуль вида c * 2^k + 1.
+     * @tparam Root Первообразный корень по модулю Modulus.
+     * @param lhs Первая последовательность.
+     * @param rhs Вторая последовательность.
+     * @param size Длина преобразования, степень двойки.
+     * @return Вычеты коэффициентов свёртки, дополненные нулями до длины size.
+     */
+    template<uint32_t Modulus, uint32_t Root, typename InputType>
+    static std::vector<uint32_t>
+    convolution_modulo(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs, size_t size);
+
+    /**
+     * @brief Привести отсчёты сигнала по модулю.
+     * @tparam Modulus Модуль.
+     * @param values Отсчёты сигнала.
+     * @param size Длина результата, недостающие вычеты равны нулю.
+     * @return Неотрицательные вычеты отсчётов.
+     */
+    template<uint32_t Modulus, typename InputType>
+    static std::vector<uint32_t> reduce(const std::vector<InputType> &values, size_t size);
+};
+
+uint32_t ntt::power(uint32_t base, uint64_t exponent, uint32_t modulus) {
+    uint64_t result = 1;
+    uint64_t current = base % modulus;
+    for (; exponent > 0; exponent >>= 1) {
+        if (exponent & 1) {
+            result = result * current % modulus;
+        }
+        current = current * current % modulus;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+template<uint32_t Modulus, uint32_t Root>
+void ntt::transform(std::vector<uint32_t> &values, bool inverse) {
+    const auto n = values.size();
+    assert((n & (n - 1)) == 0 && (Modulus - 1) % n == 0);
+
+    // Поразрядно-обратная перестановка: j пробегает номера i, записанные в обратном порядке бит.
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(values[i], values[j]);
+        }
+    }
+
+    /*
+     * Стадии бабочки те же, что и в БПФ, только корень степени len из единицы - это Root^((Modulus - 1) / len).
+     * Степени корня вычисляются точно, поэтому накопление ошибки, как у комплексных чисел, здесь не грозит.
+     */
+    std::vector<uint32_t> roots(std::max<size_t>(n / 2, 1));
+    for (size_t len = 2; len <= n; len <<= 1) {
+        auto w_len = power(Root, (Modulus - 1) / len, Modulus);
+        if (inverse) {
+            w_len = power(w_len, Modulus - 2, Modulus);
+        }
+        roots[0] = 1;
+        for (size_t j = 1; j < len / 2; ++j) {
+            roots[j] = static_cast<uint64_t>(roots[j - 1]) * w_len % Modulus;
+        }
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < len / 2; ++j) {
+                uint32_t u = values[i + j];
+                auto v = static_cast<uint32_t>(static_cast<uint64_t>(values[i + j + len / 2]) * roots[j] % Modulus);
+                values[i + j] = u + v < Modulus ? u + v : u + v - Modulus;
+                values[i + j + len / 2] = u >= v ? u - v : u + Modulus - v;
+            }
+        }
+    }
+
+    // При обратном преобразовании каждый элемент делится на n, то есть умножается на обратный к n вычет.
+    if (inverse) {
+        const uint64_t n_inverse = power(static_cast<uint32_t>(n % Modulus), Modulus - 2, Modulus);
+        for (auto &value: values) {
+            value = static_cast<uint32_t>(value * n_inverse % Modulus);
+        }
+    }
+}
+
+template<uint32_t Modulus, typename InputType>
+std::vector<uint32_t> ntt::reduce(const std::vector<InputType> &values, size_t size) {
+    std::vector<uint32_t> result(size);
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto value = static_cast<int64_t>(values[i]) % static_cast<int64_t>(Modulus);
+        result[i] = static_cast<uint32_t>(value < 0 ? value + Modulus : value);
+    }
+    return result;
+}
+
+template<uint32_t Modulus, uint32_t Root, typename InputType>
+std::vector<uint32_t>
+ntt::convolution_modulo(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs, size_t size) {
+    auto values1 = reduce<Modulus>(lhs, size);
+    transform<Modulus, Root>(values1);
+    if (&lhs == &rhs) {
+        // свёртка последовательности с самой собой: достаточно одного прямого преобразования
+        for (size_t i = 0; i < size; ++i) {
+            values1[i] = static_cast<uint32_t>(static_cast<uint64_t>(values1[i]) * values1[i] % Modulus);
+        }
+    } else {
+        auto values2 = reduce<Modulus>(rhs, size);
+        transform<Modulus, Root>(values2);
+        for (size_t i = 0; i < size; ++i) {
+            values1[i] = static_cast<uint32_t>(static_cast<uint64_t>(values1[i]) * values2[i] % Modulus);
+        }
+    }
+    transform<Modulus, Root>(values1, true);
+    return values1;
+}
+
+template<typename InputType, typename OutputIntegerType>
+std::vector<OutputIntegerType> ntt::convolution(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs) {
+    if (lhs.empty() || rhs.empty()) {
+        return {};
+    }
+    const size_t conv_length = lhs.size() + rhs.size() - 1;
+    size_t size = 1;
+    while (size < conv_length) {
+        size <<= 1;
+    }
+    assert(size <= max_length);
+
+    // Оценка сверху для модуля коэффициентов свёртки.
+    auto max_abs = [](const std::vector<InputType> &values) {
+        double result = 0;
+        for (const auto &value: values) {
+            result = std::max(result, std::abs(static_cast<double>(value)));
+        }
+        return result;
+    };
+    const double bound = max_abs(lhs) * max_abs(rhs) * static_cast<double>(std::min(lhs.size(), rhs.size()));
+
+    std::vector<OutputIntegerType> result(conv_length);
+    if (bound < modulus1 / 2) {
+        // Вычеты больше половины модуля соответствуют отрицательным коэффициентам.
+        auto residues = convolution_modulo<modulus1, 3>(lhs, rhs, size);
+        for (size_t i = 0; i < conv_length; ++i) {
+            auto value = static_cast<int64_t>(residues[i]);
+            result[i] = static_cast<OutputIntegerType>(value > modulus1 / 2 ? value - modulus1 : value);
+        }
+        return result;
+    }
+
+    /*
+     * Алгоритм Гарнера: коэффициент x = x1 + x2 * m1 + x3 * m1 * m2, где 0 <= xi < mi.
+     * Цифры xi последовательно находятся из остатков r1, r2, r3 по модулям m1, m2, m3.
+     * Произведение модулей больше 2^78, поэтому любой 64-битный коэффициент восстанавливается однозначно.
+     */
+    auto residues1 = convolution_modulo<modulus1, 3>(lhs, rhs, size);
+    auto residues2 = convolution_modulo<modulus2, 3>(lhs, rhs, size);
+    auto residues3 = convolution_modulo<modulus3, 3>(lhs, rhs, size);
+    const uint64_t m1 = modulus1, m2 = modulus2, m3 = modulus3;
+    const uint64_t m1_inverse = power(modulus1 % modulus2, m2 - 2, modulus2);  // m1^-1 mod m2
+    const uint64_t m12_inverse = power(m1 * m2 % m3, m3 - 2, modulus3);  // (m1 * m2)^-1 mod m3
+    const auto m123 = static_cast<__int128>(m1 * m2) * m3;
+    for (size_t i = 0; i < conv_length; ++i) {
+        const uint64_t x1 = residues1[i];
+        const uint64_t x2 = (residues2[i] + m2 - x1 % m2) * m1_inverse % m2;
+        const uint64_t x3 = (residues3[i] + m3 - (x1 + x2 * m1) % m3) * m12_inverse % m3;
+        auto value = static_cast<__int128>(x1 + x2 * m1) + static_cast<__int128>(x3) * (m1 * m2);
+        if (value > m123 / 2) {
+            value -= m123;
+        }
+        result[i] = static_cast<OutputIntegerType>(value);
+    }
+    return result;
+}
+
+template<typename InputType>
+std::vector<int64_t> ntt::convolution_prime(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs) {
+    if (lhs.empty() || rhs.empty()) {
+        return {};
+    }
+    const size_t conv_length = lhs.size() + rhs.size() - 1;
+    size_t size = 1;
+    while (size < conv_length) {
+        size <<= 1;
+    }
+    assert(size <= max_length);
+    auto residues = convolution_modulo<prime, 3>(lhs, rhs, size);
+    return {residues.begin(), residues.begin() + conv_length};
+}
+
+
 /**
  * @brief Содержит операции, необходимые для быстрого преобразования Фурье. Просто namespace с private-методами.
  */
 class fft {
 public:
+    /**
+     * @brief Реализации стадий бабочки.
+     * @details Векторные реализации обрабатывают за одну инструкцию 2 (SSE2) или 4 (AVX2) бабочки.
+     * Все реализации выполняют одни и те же операции в одном и том же порядке, поэтому дают одинаковый до бита результат.
+     */
+    enum class kernel {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    /**
+     * @brief Поддерживает ли процессор реализацию.
+     * @param type Реализация.
+     * @return True, если реализацию можно использовать.
+     */
+    static bool is_supported(kernel type);
+
+    /**
+     * @brief Самая быстрая реализация, которую поддерживает процессор. Определяется один раз при первом вызове.
+     */
+    static kernel best_kernel();
+
+    /**
+     * @brief План преобразования Фурье фиксированной длины.
+     * @details Хранит поразрядно-обратную перестановку и поворачивающие множители (twiddle factors),
+     * поэтому повторные преобразования одной длины не вычисляют их заново, не сортируют и не выделяют память.
+     */
+    class plan {
+    public:
+        /**
+         * @brief Построить план.
+         * @param size Длина преобразования. Должна быть степенью двойки.
+         */
+        explicit plan(size_t size);
+
+        /**
+         * @brief Длина преобразования.
+         */
+        size_t size() const {
+            return reversed_.size();
+        }
+
+        /**
+         * @brief Выполнить преобразование Фурье на месте.
+         * @details Нерекурсивная реализация. На время преобразования отсчёты раскладываются в два массива:
+         * действительные и мнимые части (SoA), чтобы стадии бабочки можно было векторизовать.
+         * @param samples Отсчёты сигнала для прямого преобразования или спектр для обратного. Длина должна совпадать с длиной плана.
+         * @param inverse True, если обратное преобразование, false - прямое.
+         * @param type Реализация стадий бабочки. Должна поддерживаться процессором.
+         */
+        void transform(std::vector<std::complex<double>> &samples, bool inverse = false,
+                       kernel type = best_kernel()) const;
+
+    private:
+        std::vector<uint32_t> reversed_;  // reversed_[i] - число i с обратным порядком log(n) младших бит
+        /*
+         * Поворачивающие множители всех стадий подряд: для блоков длины len множители w^j = exp(2*pi*i*j/len),
+         * j = 0...len/2-1, лежат начиная с позиции len/2. Каждый множитель вычислен отдельно через cos и sin,
+         * а не накоплен умножением, поэтому ошибка округления не растёт вдоль блока.
+         * Действительные и мнимые части хранятся в отдельных массивах.
+         */
+        std::vector<double> roots_re_;
+        std::vector<double> roots_im_;
+    };
+
+    /**
+     * @brief План преобразования Фурье вещественного сигнала.
+     * @details Вещественный сигнал длины n упаковывается в комплексный сигнал длины n/2: чётные отсчёты становятся
+     * действительной частью, нечётные - мнимой. Он преобразуется планом половинной длины, после чего спектры
+     * чётных и нечётных отсчётов разделяются и объединяются последней стадией бабочки.
+     * Спектр вещественного сигнала симметричен (X[n-k] = X[k]*), поэтому хранятся только отсчёты 0...n/2.
+     * Так преобразование требует вдвое меньше вычислений и памяти, чем комплексное той же длины.
+     */
+    class real_plan {
+    public:
+        /**
+         * @brief Построить план.
+         * @param size Длина вещественного сигнала. Должна быть степенью двойки, не меньше 2.
+         */
+        explicit real_plan(size_t size);
+
+        /**
+         * @brief Длина вещественного сигнала.
+         */
+        size_t size() const {
+            return 2 * half_.size();
+        }
+
+        /**
+         * @brief Прямое преобразование вещественного сигнала.
+         * @tparam SampleType Тип данных отсчётов сигнала.
+         * @param samples Отсчёты сигнала. Если их меньше длины плана, сигнал дополняется нулями.
+         * @param spectrum Сюда записываются n/2 + 1 первых отсчётов спектра.
+         */
+        template<typename SampleType>
+        void transform(const std::vector<SampleType> &samples, std::vector<std::complex<double>> &spectrum) const {
+            assert(samples.size() <= size());
+            spectrum.reserve(half_.size() + 1);
+            spectrum.assign(half_.size(), 0);
+            for (size_t i = 0; i < samples.size(); ++i) {
+                if (i % 2 == 0) {
+                    spectrum[i / 2].real(static_cast<double>(samples[i]));
+                } else {
+                    spectrum[i / 2].imag(static_cast<double>(samples[i]));
+                }
+            }
+            split_spectrum(spectrum);
+        }
+
+        /**
+         * @brief Обратное преобразование спектра вещественного сигнала.
+         * @param spectrum n/2 + 1 первых отсчётов спектра. Используется как рабочий буфер, содержимое портится.
+         * @param samples Сюда записываются n отсчётов сигнала.
+         */
+        void inverse_transform(std::vector<std::complex<double>> &spectrum, std::vector<double> &samples) const;
+
+    private:
+        /**
+         * @brief Получить спектр вещественного сигнала из спектра упакованного сигнала.
+         * @param spectrum Упакованный сигнал в первых n/2 отсчётах. Заменяется на n/2 + 1 отсчётов спектра.
+         */
+        void split_spectrum(std::vector<std::complex<double>> &spectrum) const;
+
+        const plan &half_;
+        std::vector<std::complex<double>> twiddles_;  // twiddles_[k] = exp(2*pi*i*k/n), k = 0...n/2-1
+    };
+
+    /**
+     * @brief Получить план преобразования заданной длины. Планы строятся один раз и переиспользуются.
+     * @details Можно вызывать из нескольких потоков: построенный план не изменяется.
+     * @param size Длина преобразования. Должна быть степенью двойки.
+     * @return План.
+     */
+    static const plan &get_plan(size_t size);
+
+    /**
+     * @brief Получить план преобразования вещественного сигнала. Планы строятся один раз и переиспользуются.
+     * @details Можно вызывать из нескольких потоков: построенный план не изменяется.
+     * @param length Длина сигнала. Округляется вверх до степени двойки, не меньшей 2.
+     * @return План.
+     */
+    static const real_plan &get_real_plan(size_t length);
+
+    /**
+     * @brief Выполнить преобразование Фурье на месте.
+     * @details Последовательность дополняется нулями до длины, равной степени двойки.
+     * @param samples Отсчёты сигнала, от которого берём прямое преобразование, или спектр для обратного преобразования.
+     * @param inverse True, если обратное преобразование, false - прямое.
+     */
+    static void transform_inplace(std::vector<std::complex<double>> &samples, bool inverse = false) {
+        pad(samples);
+        get_plan(samples.size()).transform(samples, inverse);
+    }
+
     /**
      * @brief Выполнить преобразование Фурье.
-     * @details Нерекурсивная реализация.
      * @param samples Отсчёты сигнала, от которого берём прямое преобразование, или спектр для обратного преобразования.
      * @param inverse True, если обратное преобразование, false - прямое.
      * @return Спектр сигнала при прямом преобразовании, отсчёты сигнала - при обратном.
      */
     static std::vector<std::complex<double>>
     transfrom(std::vector<std::complex<double>> samples, bool inverse = false) {
-        pad(samples);
-        /*
-         * Вначале к вектору a применяется поразрядно обратная перестановка, для чего вычисляется количество
-         * значащих бит (lg n) в числе n, и для каждой позиции i находится соответствующая ей позиция,
-         * битовая запись которой есть битовая запись числа i, записанная в обратном порядке.
-         * Если получившаяся в результате позиция оказалась больше i, то элементы в этих двух позициях надо обменять
-         * (если не это условие, то каждая пара обменяется дважды, и в итоге ничего не произойдёт).
-         */
-        samples = sort_by_reverse_index(samples);
+        transform_inplace(samples, inverse);
+        return samples;
+    }
 
-        /*
-         * Мы применили поразрядно обратную перестановку элементов.
-         * Теперь выполним всю работу, выполняемую нижним уровнем рекурсии, т.е. вектор отсчётов разделим на пары
-         * элементов, для каждого применим преобразование бабочки, в результате в векторе отсчётов будут находиться
-         * результаты работы нижнего уровня рекурсии. На следующем шаге разделим вектор a на четвёрки элементов,
-         * к каждой применим преобразование бабочки, в результате получим ДПФ для каждой четвёрки.
-         * И так далее, наконец, на последнем шаге мы, получив результаты ДПФ для двух половинок вектора отсчётов,
-         * применим к ним преобразование бабочки и получим ДПФ для всего вектора отсчётов.
-         */
+private:
+    fft() = default;  // запретим создание экзампляров класса
 
-        for (size_t len = 2; len <= samples.size(); len <<= 1) {
-            /*
-             * Выполняется (log(n) - 1) стадий алгоритма, на k-ой из которых (k=2...log(n)) вычисляются ДПФ для блоков
-             * длины 2^k. Для всех этих блоков будет одно и то же значение первообразного корня, которое запоминается
-             * в переменной w_current.
-             * Цикл по i итерируется по блокам,
-             * а вложенный в него цикл по j применяет преобразование бабочки ко всем элементам блока.
-             */
-            double arg = 2 * M_PI / len * (inverse ? -1 : 1);
-            std::complex<double> w_current(cos(arg), sin(arg));
-            for (int i = 0; i < samples.size(); i += len) {
-                std::complex<double> w(1);
-                for (int j = 0; j < len / 2; ++j) {
-                    std::complex<double> u = samples[i + j], v = samples[i + j + len / 2] * w;
-                    samples[i + j] = u + v;
-                    samples[i + j + len / 2] = u - v;
-                    w *= w_current;
-                }
+    /**
+     * @brief Дополнить последовательность отсчётов до длины равной степени двойки.
+     * @param samples Последовательность отсчётов.
+     */
+    static void pad(std::vector<std::complex<double>> &samples);
+
+    /**
+     * @brief Определяет наименьшую степень двойки, не меньшую заданного числа.
+     * @details Используется знание о представлении чисел с плавающей точкой в памяти.
+     * @details Подробнее: https://ru.wikipedia.org/wiki/Число_двойной_точности
+     * @param number Число, которое нужно округлить вверх до степени двойки.
+     * @return Число, равное степени двойки. Минимальное, но не меньше, чем number.
+     */
+    static size_t round_pow2(size_t number);
+
+    /**
+     * @brief Все стадии бабочки для отсчётов, уже переставленных в поразрядно-обратном порядке.
+     * @param re Действительные части отсчётов.
+     * @param im Мнимые части отсчётов.
+     * @param n Количество отсчётов, степень двойки.
+     * @param roots_re Действительные части поворачивающих множителей плана.
+     * @param roots_im Мнимые части поворачивающих множителей плана.
+     * @param sign 1 для прямого преобразования, -1 для обратного (множители заменяются сопряжёнными).
+     */
+    static void butterflies_scalar(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                                   double sign);
+#if defined(__x86_64__) || defined(__i386__)
+    static void butterflies_sse2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                                 double sign);
+    static void butterflies_avx2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                                 double sign);
+#endif
+
+    /**
+     * @brief Одна стадия бабочки без векторизации: для блоков длины len, начиная с позиции, кратной len.
+     * @details Используется скалярной реализацией и векторными для коротких блоков.
+     */
+    static void stage_scalar(double *re, double *im, size_t n, size_t len, const double *roots_re,
+                             const double *roots_im, double sign) {
+        const size_t half = len / 2;
+        for (size_t i = 0; i + len <= n; i += len) {
+            for (size_t j = 0; j < half; ++j) {
+                const double w_re = roots_re[half + j], w_im = sign * roots_im[half + j];
+                const double v_re = re[i + j + half] * w_re - im[i + j + half] * w_im;
+                const double v_im = re[i + j + half] * w_im + im[i + j + half] * w_re;
+                re[i + j + half] = re[i + j] - v_re;
+                im[i + j + half] = im[i + j] - v_im;
+                re[i + j] = re[i + j] + v_re;
+                im[i + j] = im[i + j] + v_im;
             }
         }
-        /*
-         * Если указан флаг inverse = true, то w_n заменяется на w_n^-1, а каждый элемент результата делится на 2
-         * (учитывая, что эти деления на 2 произойдут в каждом уровне рекурсии, то в итоге как раз получится,
-         * что все элементы поделятся на n).
-         */
-        if (inverse) {
-            std::for_each(samples.begin(), samples.end(), [&samples](auto &sample) { sample /= samples.size(); });
+    }
+};
+
+
+fft::plan::plan(size_t size)
+        : reversed_(size), roots_re_(std::max<size_t>(size, 2)), roots_im_(std::max<size_t>(size, 2)) {
+    /*
+     * Поразрядно-обратная перестановка за O(n): запись числа i в обратном порядке - это запись числа i / 2
+     * в обратном порядке, сдвинутая на один разряд, к которой слева дописан младший бит i.
+     */
+    size_t log_size = 0;
+    while ((static_cast<size_t>(1) << log_size) < size) {
+        ++log_size;
+    }
+    for (size_t i = 1; i < size; ++i) {
+        reversed_[i] = (reversed_[i >> 1] >> 1) | ((i & 1) << (log_size - 1));
+    }
+
+    /*
+     * Множители последней стадии вычисляем напрямую, множители предыдущих стадий - это каждый второй,
+     * каждый четвёртый и т.д. множитель последней стадии.
+     */
+    const auto half = size / 2;
+    for (size_t j = 0; j < half; ++j) {
+        double arg = 2 * M_PI * j / size;
+        roots_re_[half + j] = cos(arg);
+        roots_im_[half + j] = sin(arg);
+    }
+    for (size_t len = half; len >= 2; len >>= 1) {
+        for (size_t j = 0; j < len / 2; ++j) {
+            roots_re_[len / 2 + j] = roots_re_[half + j * (size / len)];
+            roots_im_[len / 2 + j] = roots_im_[half + j * (size / len)];
+        }
+    }
+}
+
+void fft::plan::transform(std::vector<std::complex<double>> &samples, bool inverse, kernel type) const {
+    assert(samples.size() == size());
+    assert(is_supported(type));
+    /*
+     * Вначале к вектору a применяется поразрядно обратная перестановка:
+     * на позицию i попадает элемент с позиции, битовая запись которой есть битовая запись числа i в обратном порядке.
+     * Одновременно раскладываем отсчёты на действительные и мнимые части.
+     * Буферы свои у каждого потока и переиспользуются между вызовами.
+     */
+    thread_local std::vector<double> re, im;
+    re.resize(samples.size());
+    im.resize(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        re[i] = samples[reversed_[i]].real();
+        im[i] = samples[reversed_[i]].imag();
+    }
+
+    /*
+     * Мы применили поразрядно обратную перестановку элементов.
+     * Теперь выполним всю работу, выполняемую нижним уровнем рекурсии, т.е. вектор отсчётов разделим на пары
+     * элементов, для каждого применим преобразование бабочки, в результате в векторе отсчётов будут находиться
+     * результаты работы нижнего уровня рекурсии. На следующем шаге разделим вектор a на четвёрки элементов,
+     * к каждой применим преобразование бабочки, в результате получим ДПФ для каждой четвёрки.
+     * И так далее, наконец, на последнем шаге мы, получив результаты ДПФ для двух половинок вектора отсчётов,
+     * применим к ним преобразование бабочки и получим ДПФ для всего вектора отсчётов.
+     * Для обратного преобразования w_n заменяется на w_n^-1, то есть на сопряжённое число.
+     */
+    const double sign = inverse ? -1.0 : 1.0;
+    switch (type) {
+#if defined(__x86_64__) || defined(__i386__)
+        case kernel::avx2:
+            butterflies_avx2(re.data(), im.data(), samples.size(), roots_re_.data(), roots_im_.data(), sign);
+            break;
+        case kernel::sse2:
+            butterflies_sse2(re.data(), im.data(), samples.size(), roots_re_.data(), roots_im_.data(), sign);
+            break;
+#endif
+        default:
+            butterflies_scalar(re.data(), im.data(), samples.size(), roots_re_.data(), roots_im_.data(), sign);
+            break;
+    }
+
+    /*
+     * При обратном преобразовании каждый элемент результата делится на n.
+     */
+    const double scale = inverse ? 1.0 / samples.size() : 1.0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = std::complex<double>(re[i] * scale, im[i] * scale);
+    }
+}
+
+bool fft::is_supported(kernel type) {
+    switch (type) {
+        case kernel::scalar:
+            return true;
+#if defined(__x86_64__) || defined(__i386__)
+        case kernel::sse2:
+            return __builtin_cpu_supports("sse2");
+        case kernel::avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+fft::kernel fft::best_kernel() {
+    static const kernel best = is_supported(kernel::avx2) ? kernel::avx2 :
+                               is_supported(kernel::sse2) ? kernel::sse2 : kernel::scalar;
+    return best;
+}
+
+void fft::butterflies_scalar(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                             double sign) {
+    for (size_t len = 2; len <= n; len <<= 1) {
+        stage_scalar(re, im, n, len, roots_re, roots_im, sign);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+ * Векторные реализации обрабатывают бабочки j, j+1, ... блока одновременно: в массивах SoA соседние
+ * действительные (и мнимые) части лежат подряд, поэтому загружаются одной инструкцией.
+ * Блоки короче ширины вектора обрабатываются скалярно. FMA не используется, чтобы результат совпадал со скалярным.
+ */
+__attribute__((target("sse2")))
+void fft::butterflies_sse2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                           double sign) {
+    stage_scalar(re, im, n, 2, roots_re, roots_im, sign);
+    const __m128d sign_vector = _mm_set1_pd(sign);
+    for (size_t len = 4; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; j += 2) {
+                const __m128d w_re = _mm_loadu_pd(roots_re + half + j);
+                const __m128d w_im = _mm_mul_pd(sign_vector, _mm_loadu_pd(roots_im + half + j));
+                const __m128d x_re = _mm_loadu_pd(re + i + j + half), x_im = _mm_loadu_pd(im + i + j + half);
+                const __m128d v_re = _mm_sub_pd(_mm_mul_pd(x_re, w_re), _mm_mul_pd(x_im, w_im));
+                const __m128d v_im = _mm_add_pd(_mm_mul_pd(x_re, w_im), _mm_mul_pd(x_im, w_re));
+                const __m128d u_re = _mm_loadu_pd(re + i + j), u_im = _mm_loadu_pd(im + i + j);
+                _mm_storeu_pd(re + i + j + half, _mm_sub_pd(u_re, v_re));
+                _mm_storeu_pd(im + i + j + half, _mm_sub_pd(u_im, v_im));
+                _mm_storeu_pd(re + i + j, _mm_add_pd(u_re, v_re));
+                _mm_storeu_pd(im + i + j, _mm_add_pd(u_im, v_im));
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void fft::butterflies_avx2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                           double sign) {
+    stage_scalar(re, im, n, 2, roots_re, roots_im, sign);
+    stage_scalar(re, im, n, 4, roots_re, roots_im, sign);
+    const __m256d sign_vector = _mm256_set1_pd(sign);
+    for (size_t len = 8; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; j += 4) {
+                const __m256d w_re = _mm256_loadu_pd(roots_re + half + j);
+                const __m256d w_im = _mm256_mul_pd(sign_vector, _mm256_loadu_pd(roots_im + half + j));
+                const __m256d x_re = _mm256_loadu_pd(re + i + j + half), x_im = _mm256_loadu_pd(im + i + j + half);
+                const __m256d v_re = _mm256_sub_pd(_mm256_mul_pd(x_re, w_re), _mm256_mul_pd(x_im, w_im));
+                const __m256d v_im = _mm256_add_pd(_mm256_mul_pd(x_re, w_im), _mm256_mul_pd(x_im, w_re));
+                const __m256d u_re = _mm256_loadu_pd(re + i + j), u_im = _mm256_loadu_pd(im + i + j);
+                _mm256_storeu_pd(re + i + j + half, _mm256_sub_pd(u_re, v_re));
+                _mm256_storeu_pd(im + i + j + half, _mm256_sub_pd(u_im, v_im));
+                _mm256_storeu_pd(re + i + j, _mm256_add_pd(u_re, v_re));
+                _mm256_storeu_pd(im + i + j, _mm256_add_pd(u_im, v_im));
+            }
         }
+    }
+}
+
+#endif
+
+const fft::plan &fft::get_plan(size_t size) {
+    // планы храним по логарифму длины: длин, являющихся степенью двойки, немного
+    static std::vector<std::unique_ptr<plan>> plans(sizeof(size_t) * 8);
+    static std::mutex plans_mutex;  // без блокировки два потока могли бы одновременно строить план одной длины
+    size_t log_size = 0;
+    while ((static_cast<size_t>(1) << log_size) < size) {
+        ++log_size;
+    }
+    std::lock_guard<std::mutex> lock(plans_mutex);
+    if (!plans[log_size]) {
+        plans[log_size] = std::make_unique<plan>(size);
+    }
+    return *plans[log_size];
+}
+
+fft::real_plan::real_plan(size_t size) : half_(get_plan(size / 2)), twiddles_(size / 2) {
+    assert(size >= 2);
+    for (size_t k = 0; k < twiddles_.size(); ++k) {
+        double arg = 2 * M_PI * k / size;
+        twiddles_[k] = std::complex<double>(cos(arg), sin(arg));
+    }
+}
+
+void fft::real_plan::split_spectrum(std::vector<std::complex<double>> &spectrum) const {
+    using namespace std::complex_literals;
+    /*
+     * z(m) = x(2m) + i x(2m+1), Z = FFT(z) длины n/2.
+     * Спектры чётных и нечётных отсчётов: E[k] = (Z[k] + Z[n/2-k]*)/2, O[k] = -i(Z[k] - Z[n/2-k]*)/2.
+     * Спектр сигнала: X[k] = E[k] + w^k O[k], w = exp(2*pi*i/n).
+     * E и O - спектры вещественных сигналов, поэтому E[n/2-k] = E[k]*, O[n/2-k] = O[k]*,
+     * и отсчёты k и n/2-k вычисляются вместе, на месте.
+     */
+    const auto half = half_.size();
+    half_.transform(spectrum);
+    spectrum.resize(half + 1);
+    const auto z0 = spectrum[0];
+    spectrum[0] = z0.real() + z0.imag();
+    spectrum[half] = z0.real() - z0.imag();
+    for (size_t k = 1; k <= half / 2; ++k) {
+        const auto z_k = spectrum[k], z_m = std::conj(spectrum[half - k]);
+        const auto even = (z_k + z_m) / 2.0, odd = -1.0i * (z_k - z_m) / 2.0;
+        spectrum[k] = even + twiddles_[k] * odd;
+        spectrum[half - k] = std::conj(even) + twiddles_[half - k] * std::conj(odd);
+    }
+}
+
+void fft::real_plan::inverse_transform(std::vector<std::complex<double>> &spectrum, std::vector<double> &samples) const {
+    using namespace std::complex_literals;
+    /*
+     * Обратные действия: E[k] = (X[k] + X[n/2-k]*)/2, O[k] = w^-k (X[k] - X[n/2-k]*)/2,
+     * Z[k] = E[k] + i O[k], затем обратное преобразование половинной длины даёт чётные и нечётные отсчёты.
+     */
+    const auto half = half_.size();
+    assert(spectrum.size() == half + 1);
+    const auto x0 = spectrum[0].real(), x_half = spectrum[half].real();
+    spectrum[0] = std::complex<double>((x0 + x_half) / 2.0, (x0 - x_half) / 2.0);
+    for (size_t k = 1; k <= half / 2; ++k) {
+        const auto x_k = spectrum[k], x_m = std::conj(spectrum[half - k]);
+        const auto even = (x_k + x_m) / 2.0, odd = std::conj(twiddles_[k]) * (x_k - x_m) / 2.0;
+        spectrum[k] = even + 1.0i * odd;
+        spectrum[half - k] = std::conj(even) + 1.0i * std::conj(odd);
+    }
+    spectrum.resize(half);
+    half_.transform(spectrum, true);
+    samples.resize(size());
+    for (size_t m = 0; m < half; ++m) {
+        samples[2 * m] = spectrum[m].real();
+        samples[2 * m + 1] = spectrum[m].imag();
+    }
+}
+
+const fft::real_plan &fft::get_real_plan(size_t length) {
+    static std::vector<std::unique_ptr<real_plan>> plans(sizeof(size_t) * 8);
+    static std::mutex plans_mutex;
+    size_t log_size = 1;
+    while ((static_cast<size_t>(1) << log_size) < length) {
+        ++log_size;
+    }
+    // план половинной длины берётся из get_plan под другой блокировкой, поэтому взаимной блокировки нет
+    std::lock_guard<std::mutex> lock(plans_mutex);
+    if (!plans[log_size]) {
+        plans[log_size] = std::make_unique<real_plan>(static_cast<size_t>(1) << log_size);
+    }
+    return *plans[log_size];
+}
+
+size_t fft::round_pow2(size_t number) {
+    double x = static_cast<double>(number - 1);  // если убрать "- 1", то "не меньше" в описании нужно заменить на "больше"
+    auto answer = reinterpret_cast<unsigned int *>(&x);
+    ++answer;
+    return static_cast<size_t>(1) << (((*answer & 0x7FF00000) >> 20) - 1022);
+}
+
+void fft::pad(std::vector<std::complex<double>> &samples) {
+    size_t new_size = round_pow2(samples.size());
+    samples.resize(new_size);
+}
+
+/**
+ * @brief Класс, описывающий многочлен с целочисленными коэффициентами.
+ */
+class Polynom {
+public:
+    Polynom() = default;
+
+    /**
+     * @brief Конструирует многочлен из набора коэффициентов.
+     * @param coefficients Массив коэффициентов. Первый - свободный член. Последний - коэффициент при максимальной степени x.
+     */
+    explicit Polynom(std::vector<int64_t> coefficients) : coefficients_(std::move(coefficients)) {}
+
+    /**
+     * @brief Представляет число в виде многочлена.
+     * @tparam IntegerType Тип данных числа.
+     * @param number Целое число.
+     * @param base Основание системы счисления.
+     */
+    template<typename IntegerType>
+    explicit Polynom(IntegerType number, int16_t base = 10) {
+        while (number != 0) {
+            coefficients_.emplace_back(number % base);
+            number /= base;
+        }
+    }
+
+    /**
+     * @brief Представляет длинное число в виде многочлена.
+     * @details Основание системы счисления == 10^digits: каждый коэффициент хранит digits десятичных цифр.
+     * @param number Число, записанное в строке.
+     * @param digits Количество десятичных цифр в одном коэффициенте.
+     */
+    explicit Polynom(const std::string &number, size_t digits = 1) {
+        const size_t begin = (!number.empty() && !std::isdigit(number[0])) ? 1 : 0;
+        coefficients_.reserve((number.size() - begin + digits - 1) / digits);
+        for (size_t end = number.size(); end > begin;) {
+            const size_t start = end - std::min(digits, end - begin);
+            int64_t coefficient = 0;
+            for (size_t i = start; i < end; ++i) {
+                coefficient = coefficient * 10 + (number[i] - '0');
+            }
+            coefficients_.push_back(coefficient);
+            end = start;
+        }
+    }
+
+    /**
+     * @brief Коэффициенты многочлена. Первый - свободный член.
+     */
+    const std::vector<int64_t> &get_coefficients() const {
+        return coefficients_;
+    }
+
+    /**
+     * @brief Вычислить значение многочлена.
+     * @param x Значение x. Аргумент многочлена. Точка, в которой вычисляем значение.
+     * @return Значение многочлена.
+     */
+    int64_t calculate_value(int64_t x) const {
+        int64_t result = 0;
+        for (auto iter = coefficients_.rbegin(); iter != coefficients_.rend(); ++iter) {
+            result *= x;
+            result += *iter;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Преобразует многочлен в длинное целое число.
+     * @details Основание системы счисления == 10^digits. Коэффициенты могут превышать основание,
+     * например, после умножения: лишнее переносится в старшие разряды.
+     * @param digits Количество десятичных цифр в одном коэффициенте.
+     * @return Строка с записанным в ней целым числом.
+     */
+    std::string to_string_number(size_t digits = 1) const {
+        int64_t base = 1;
+        for (size_t i = 0; i < digits; ++i) {
+            base *= 10;
+        }
+        std::vector<int64_t> normalized;
+        normalized.reserve(coefficients_.size() + 1);
+        int64_t shifted = 0;
+        for (auto coefficient: coefficients_) {
+            shifted += coefficient;
+            normalized.push_back(shifted % base);
+            shifted /= base;
+        }
+        while (shifted != 0) {
+            normalized.push_back(shifted % base);
+            shifted /= base;
+        }
+        while (!normalized.empty() && normalized.back() == 0) {
+            normalized.pop_back();
+        }
+        if (normalized.empty()) {
+            return "0";
+        }
+        // старший коэффициент печатаем как есть, остальные дополняем ведущими нулями до digits цифр
+        std::string result = std::to_string(normalized.back());
+        result.reserve(normalized.size() * digits);
+        for (auto iter = std::next(normalized.rbegin()); iter != normalized.rend(); ++iter) {
+            auto part = std::to_string(*iter);
+            result.append(digits - part.size(), '0');
+            result += part;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Умножение многочленов.
+     * @details Алгоритм выбирается по размеру множителей: умножение "в столбик" для коротких,
+     * алгоритм Карацубы для средних, fft (или NTT, если точности fft не хватит) для длинных.
+     * @param rhs Второй множитель.
+     * @return Значение произведения.
+     */
+    Polynom operator*(const Polynom &rhs) const {
+        if (coefficients_.empty() || rhs.coefficients_.empty()) {
+            return Polynom();
+        }
+        const auto shorter = std::min(coefficients_.size(), rhs.coefficients_.size());
+        if (shorter <= schoolbook_threshold) {
+            return Polynom(multiply_schoolbook(coefficients_, rhs.coefficients_));
+        }
+        if (coefficients_.size() + rhs.coefficients_.size() <= karatsuba_threshold) {
+            return Polynom(multiply_karatsuba(coefficients_, rhs.coefficients_));
+        }
+        return Polynom(multiply_fft(coefficients_, rhs.coefficients_));
+    }
+
+    /*
+     * Операции ниже выполняются в поле вычетов по простому модулю: в нём любой ненулевой коэффициент обратим,
+     * а умножение точно выполняется через NTT. Результаты - вычеты от 0 до modulus - 1.
+     */
+    static constexpr int64_t modulus = ntt::prime;
+
+    /**
+     * @brief Обратный ряд по модулю x^length: такой многочлен G, что F * G = 1 + O(x^length).
+     * @details Итерации Ньютона G' = G * (2 - F * G), каждая удваивает количество верных коэффициентов. O(n log n).
+     * @param length Количество коэффициентов результата.
+     * @return Обратный ряд. Свободный член многочлена должен быть обратим по модулю.
+     */
+    Polynom inverse(size_t length) const {
+        return Polynom(inverse_series(reduce_modulo(coefficients_), length));
+    }
+
+    /**
+     * @brief Деление с остатком: *this = divisor * quotient + remainder, степень остатка меньше степени делителя.
+     * @details Частное находится через обратный ряд перевёрнутого делителя за O(n log n).
+     * @param divisor Делитель. Не нулевой по модулю.
+     * @return Пара: частное, остаток.
+     */
+    std::pair<Polynom, Polynom> divide(const Polynom &divisor) const {
+        auto[quotient, remainder] = divide_modulo(trim(reduce_modulo(coefficients_)),
+                                                  trim(reduce_modulo(divisor.coefficients_)));
+        return {Polynom(std::move(quotient)), Polynom(std::move(remainder))};
+    }
+
+    /**
+     * @brief Вычислить значения многочлена во многих точках.
+     * @details Дерево произведений (x - x_i) по отрезкам точек: остаток от деления на произведение по отрезку
+     * совпадает с многочленом во всех точках отрезка. Спускаясь по дереву, делим остаток на произведения
+     * по половинам отрезка. O(n log^2 n) вместо O(n^2) для схемы Горнера в каждой точке.
+     * @param points Точки.
+     * @return Значения многочлена в точках.
+     */
+    std::vector<int64_t> evaluate(const std::vector<int64_t> &points) const;
+
+    /**
+     * @brief Интерполяция: многочлен степени меньше n, принимающий в n точках заданные значения.
+     * @details Формула Лагранжа: P = sum(y_i / M'(x_i) * M(x) / (x - x_i)), M = prod(x - x_i).
+     * Значения M' в точках находятся вычислением во многих точках, а сумма собирается по дереву произведений
+     * снизу вверх. O(n log^2 n).
+     * @param points Точки. Попарно различные по модулю.
+     * @param values Значения в точках.
+     * @return Многочлен.
+     */
+    static Polynom interpolate(const std::vector<int64_t> &points, const std::vector<int64_t> &values);
+
+private:
+    // пороги выбора алгоритма умножения, подобраны замерами
+    static constexpr size_t schoolbook_threshold = 32;  // длина более короткого множителя
+    static constexpr size_t karatsuba_threshold = 256;  // суммарная длина множителей
+    // Граница модуля коэффициентов произведения, до которой округление результата fft надёжно.
+    static constexpr double fft_precision_limit = 1e14;
+
+    /**
+     * @brief Умножение "в столбик" за O(n * m).
+     * @param lhs Коэффициенты первого множителя.
+     * @param rhs Коэффициенты второго множителя.
+     * @return Коэффициенты произведения.
+     */
+    static std::vector<int64_t> multiply_schoolbook(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs) {
+        std::vector<int64_t> result(lhs.size() + rhs.size() - 1);
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            for (size_t j = 0; j < rhs.size(); ++j) {
+                result[i + j] += lhs[i] * rhs[j];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Умножение алгоритмом Карацубы за O(n^log2(3)).
+     * @param lhs Коэффициенты первого множителя.
+     * @param rhs Коэффициенты второго множителя.
+     * @return Коэффициенты произведения.
+     */
+    static std::vector<int64_t> multiply_karatsuba(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs);
+
+    /**
+     * @brief Умножение с помощью fft за O(n log n).
+     * @details Если коэффициенты произведения слишком велики для точного округления результата fft,
+     * используется NTT с восстановлением по китайской теореме об остатках.
+     * @param lhs Коэффициенты первого множителя.
+     * @param rhs Коэффициенты второго множителя.
+     * @return Коэффициенты произведения.
+     */
+    static std::vector<int64_t> multiply_fft(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs);
+
+    // количество точек, начиная с которого значения вычисляются по дереву, а не схемой Горнера
+    static constexpr size_t subproduct_threshold = 64;
+
+    /**
+     * @brief Привести коэффициенты (или точки) по модулю.
+     */
+    static std::vector<int64_t> reduce_modulo(const std::vector<int64_t> &coefficients);
+
+    /**
+     * @brief Отбросить нулевые старшие коэффициенты.
+     */
+    static std::vector<int64_t> trim(std::vector<int64_t> coefficients) {
+        while (!coefficients.empty() && coefficients.back() == 0) {
+            coefficients.pop_back();
+        }
+        return coefficients;
+    }
+
+    /**
+     * @brief Умножение по модулю: "в столбик" для коротких множителей, NTT для длинных.
+     * @param lhs Вычеты коэффициентов первого множителя.
+     * @param rhs Вычеты коэффициентов второго множителя.
+     * @return Вычеты коэффициентов произведения.
+     */
+    static std::vector<int64_t> multiply_modulo(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs);
+
+    /**
+     * @brief Обратный ряд по модулю x^length, см. inverse.
+     */
+    static std::vector<int64_t> inverse_series(const std::vector<int64_t> &coefficients, size_t length);
+
+    /**
+     * @brief Деление с остатком по модулю, см. divide.
+     * @param dividend Вычеты коэффициентов делимого без старших нулей.
+     * @param divisor Вычеты коэффициентов делителя без старших нулей.
+     * @return Пара: частное, остаток, оба без старших нулей.
+     */
+    static std::pair<std::vector<int64_t>, std::vector<int64_t>>
+    divide_modulo(const std::vector<int64_t> &dividend, const std::vector<int64_t> &divisor);
+
+    /**
+     * @brief Дерево произведений: в вершине node для точек begin...end-1 хранится prod(x - x_i).
+     * @details Вершины нумеруются как в дереве отрезков: дети вершины node - 2 * node и 2 * node + 1.
+     */
+    static void build_subproduct_tree(std::vector<std::vector<int64_t>> &tree, size_t node, size_t begin, size_t end,
+                                      const std::vector<int64_t> &points);
+
+    /**
+     * @brief Значения многочлена в точках begin...end-1 спуском по дереву произведений.
+     */
+    static void evaluate_tree(const std::vector<int64_t> &coefficients, const std::vector<std::vector<int64_t>> &tree,
+                              size_t node, size_t begin, size_t end, const std::vector<int64_t> &points,
+                              std::vector<int64_t> &values);
+
+    /**
+     * @brief Сумма sum(w_i * M(x) / (x - x_i)) по точкам begin...end-1, M - произведение в вершине дерева.
+     */
+    static std::vector<int64_t> combine_tree(const std::vector<int64_t> &weights,
+                                             const std::vector<std::vector<int64_t>> &tree,
+                                             size_t node, size_t begin, size_t end);
+
+    std::vector<int64_t> coefficients_;
+};
+
+std::vector<int64_t> Polynom::multiply_karatsuba(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs) {
+    const auto &shorter = lhs.size() < rhs.size() ? lhs : rhs;
+    const auto &longer = lhs.size() < rhs.size() ? rhs : lhs;
+    if (shorter.size() <= schoolbook_threshold) {
+        return multiply_schoolbook(lhs, rhs);
+    }
+    std::vector<int64_t> result(lhs.size() + rhs.size() - 1);
+    const size_t half = (longer.size() + 1) / 2;
+
+    /*
+     * Если множители сильно различаются по длине, делим длинный на куски длины короткого
+     * и складываем произведения короткого множителя на каждый кусок со сдвигом.
+     */
+    if (shorter.size() <= half) {
+        for (size_t offset = 0; offset < longer.size(); offset += shorter.size()) {
+            std::vector<int64_t> chunk(longer.begin() + offset,
+                                       longer.begin() + std::min(offset + shorter.size(), longer.size()));
+            auto part = multiply_karatsuba(shorter, chunk);
+            for (size_t i = 0; i < part.size(); ++i) {
+                result[offset + i] += part[i];
+            }
+        }
+        return result;
+    }
+
+    /*
+     * A = A0 + x^h * A1, B = B0 + x^h * B1.
+     * A * B = A0 * B0 + x^h * ((A0 + A1) * (B0 + B1) - A0 * B0 - A1 * B1) + x^(2h) * A1 * B1,
+     * то есть три умножения половинной длины вместо четырёх.
+     */
+    std::vector<int64_t> lhs_low(lhs.begin(), lhs.begin() + half), lhs_high(lhs.begin() + half, lhs.end());
+    std::vector<int64_t> rhs_low(rhs.begin(), rhs.begin() + half), rhs_high(rhs.begin() + half, rhs.end());
+    auto low = multiply_karatsuba(lhs_low, rhs_low);
+    auto high = multiply_karatsuba(lhs_high, rhs_high);
+    for (size_t i = 0; i < lhs_high.size(); ++i) {
+        lhs_low[i] += lhs_high[i];
+    }
+    for (size_t i = 0; i < rhs_high.size(); ++i) {
+        rhs_low[i] += rhs_high[i];
+    }
+    auto middle = multiply_karatsuba(lhs_low, rhs_low);
+    for (size_t i = 0; i < low.size(); ++i) {
+        middle[i] -= low[i];
+        result[i] += low[i];
+    }
+    for (size_t i = 0; i < high.size(); ++i) {
+        middle[i] -= high[i];
+        result[i + 2 * half] += high[i];
+    }
+    for (size_t i = 0; i < middle.size() && i + half < result.size(); ++i) {
+        result[i + half] += middle[i];
+    }
+    return result;
+}
+
+std::vector<int64_t> Polynom::multiply_fft(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs) {
+    /*
+     * Пусть даны два многочлена A и B.
+     * Посчитаем ДПФ для каждого из них.
+     * Что происходит при умножении многочленов? В каждой точке их значения просто перемножаются.
+     * Но это означает, что если мы перемножим спектры, просто умножив каждый элемент одного вектора на
+     * соответствующий ему элемент другого вектора, то мы получим не что иное, как ДПФ от произведения.
+     * Наконец, применяя обратное ДПФ, получаем произведение.
+     *
+     * Поэлементное умножение спектром, очевидно, требует для вычисления только O(n) операций.
+     * Таким образом, если мы научимся вычислять ДПФ и обратное ДПФ за время O(n log n),
+     * то и произведение двух полиномов (а, следовательно, и двух длинных чисел) мы сможем найти за O(n log n).
+     *
+     * Следует заметить, что, во-первых, два многочлена следует привести к одной степени
+     * (просто дополнив коэффициенты одного из них нулями).
+     * Во-вторых, в результате произведения двух многочленов степени n получается многочлен степени 2n-1.
+     */
+    auto max_abs = [](const std::vector<int64_t> &values) {
+        int64_t result = 0;
+        for (auto value: values) {
+            result = std::max(result, std::abs(value));
+        }
+        return static_cast<double>(result);
+    };
+    const double bound = max_abs(lhs) * max_abs(rhs) * static_cast<double>(std::min(lhs.size(), rhs.size()));
+    if (bound >= fft_precision_limit) {
+        return ntt::convolution<int64_t, int64_t>(lhs, rhs);
+    }
+
+    /*
+     * Коэффициенты вещественные, поэтому используем преобразование вещественного сигнала:
+     * оно вдвое дешевле комплексного и хранит только половину спектра.
+     */
+    const size_t production_length = lhs.size() + rhs.size() - 1;
+    const auto &plan = fft::get_real_plan(production_length);
+
+    std::vector<std::complex<double>> spectrum1, spectrum2;
+    plan.transform(lhs, spectrum1);
+    plan.transform(rhs, spectrum2);
+    for (size_t i = 0; i < spectrum1.size(); ++i) {
+        spectrum1[i] *= spectrum2[i];
+    }
+    std::vector<double> production_samples;
+    plan.inverse_transform(spectrum1, production_samples);
+
+    std::vector<int64_t> production_coefficients;
+    production_coefficients.reserve(production_length);
+    for (size_t i = 0; i < production_length; ++i) {
+        production_coefficients.push_back(std::llround(production_samples[i]));
+    }
+    return production_coefficients;
+}
+
+std::vector<int64_t> Polynom::reduce_modulo(const std::vector<int64_t> &coefficients) {
+    std::vector<int64_t> result;
+    result.reserve(coefficients.size());
+    for (auto coefficient: coefficients) {
+        coefficient %= modulus;
+        result.push_back(coefficient < 0 ? coefficient + modulus : coefficient);
+    }
+    return result;
+}
+
+std::vector<int64_t> Polynom::multiply_modulo(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs) {
+    if (lhs.empty() || rhs.empty()) {
+        return {};
+    }
+    if (std::min(lhs.size(), rhs.size()) > schoolbook_threshold) {
+        return ntt::convolution_prime(lhs, rhs);
+    }
+    std::vector<int64_t> result(lhs.size() + rhs.size() - 1);
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        for (size_t j = 0; j < rhs.size(); ++j) {
+            result[i + j] = (result[i + j] + lhs[i] * rhs[j]) % modulus;
+        }
+    }
+    return result;
+}
+
+std::vector<int64_t> Polynom::inverse_series(const std::vector<int64_t> &coefficients, size_t length) {
+    assert(!coefficients.empty() && coefficients[0] != 0);
+    std::vector<int64_t> result{ntt::power(coefficients[0], modulus - 2, modulus)};
+    /*
+     * Если F * G = 1 + O(x^k), то для G' = G * (2 - F * G) верно F * G' = 1 + O(x^2k):
+     * 1 - F * G' = (1 - F * G)^2. Поэтому на каждом шаге достаточно 2k младших коэффициентов F.
+     */
+    for (size_t current = 1; current < length; current *= 2) {
+        std::vector<int64_t> part(coefficients.begin(),
+                                  coefficients.begin() + std::min(coefficients.size(), 2 * current));
+        auto correction = multiply_modulo(part, result);
+        correction.resize(2 * current);
+        for (auto &coefficient: correction) {
+            coefficient = (modulus - coefficient) % modulus;
+        }
+        correction[0] = (correction[0] + 2) % modulus;
+        result = multiply_modulo(result, correction);
+        result.resize(2 * current);
+    }
+    result.resize(length);
+    return result;
+}
+
+std::pair<std::vector<int64_t>, std::vector<int64_t>>
+Polynom::divide_modulo(const std::vector<int64_t> &dividend, const std::vector<int64_t> &divisor) {
+    assert(!divisor.empty());
+    if (dividend.size() < divisor.size()) {
+        return {{}, dividend};
+    }
+    /*
+     * Перевернём многочлены: rev(A) = x^n * A(1/x). Из A = B * Q + R следует
+     * rev(A) = rev(B) * rev(Q) + x^(n-m+1) * rev(R), то есть rev(Q) = rev(A) / rev(B) по модулю x^(n-m+1).
+     * Свободный член rev(B) - старший коэффициент B, он не нулевой, поэтому rev(B) обратим.
+     */
+    const size_t quotient_length = dividend.size() - divisor.size() + 1;
+    std::vector<int64_t> reversed_dividend(dividend.rbegin(), dividend.rbegin() + quotient_length);
+    std::vector<int64_t> reversed_divisor(divisor.rbegin(),
+                                          divisor.rbegin() + std::min(divisor.size(), quotient_length));
+    auto quotient = multiply_modulo(reversed_dividend, inverse_series(reversed_divisor, quotient_length));
+    quotient.resize(quotient_length);
+    std::reverse(quotient.begin(), quotient.end());
+
+    // R = A - B * Q, степень остатка меньше степени делителя
+    auto product = multiply_modulo(divisor, quotient);
+    std::vector<int64_t> remainder(divisor.size() - 1);
+    for (size_t i = 0; i < remainder.size(); ++i) {
+        remainder[i] = (dividend[i] - product[i] + modulus) % modulus;
+    }
+    return {trim(std::move(quotient)), trim(std::move(remainder))};
+}
+
+void Polynom::build_subproduct_tree(std::vector<std::vector<int64_t>> &tree, size_t node, size_t begin, size_t end,
+                                    const std::vector<int64_t> &points) {
+    if (end - begin == 1) {
+        tree[node] = {(modulus - points[begin]) % modulus, 1};
+        return;
+    }
+    const size_t middle = (begin + end) / 2;
+    build_subproduct_tree(tree, 2 * node, begin, middle, points);
+    build_subproduct_tree(tree, 2 * node + 1, middle, end, points);
+    tree[node] = multiply_modulo(tree[2 * node], tree[2 * node + 1]);
+}
+
+void Polynom::evaluate_tree(const std::vector<int64_t> &coefficients, const std::vector<std::vector<int64_t>> &tree,
+                            size_t node, size_t begin, size_t end, const std::vector<int64_t> &points,
+                            std::vector<int64_t> &values) {
+    if (end - begin <= subproduct_threshold) {
+        // остаток короче, чем количество точек, поэтому схема Горнера здесь дешевле дальнейшего деления
+        for (size_t i = begin; i < end; ++i) {
+            int64_t value = 0;
+            for (auto iter = coefficients.rbegin(); iter != coefficients.rend(); ++iter) {
+                value = (value * points[i] + *iter) % modulus;
+            }
+            values[i] = value;
+        }
+        return;
+    }
+    const size_t middle = (begin + end) / 2;
+    evaluate_tree(divide_modulo(coefficients, tree[2 * node]).second, tree, 2 * node, begin, middle, points, values);
+    evaluate_tree(divide_modulo(coefficients, tree[2 * node + 1]).second, tree, 2 * node + 1, middle, end, points,
+                  values);
+}
+
+std::vector<int64_t> Polynom::evaluate(const std::vector<int64_t> &points) const {
+    std::vector<int64_t> values(points.size());
+    if (points.empty()) {
+        return values;
+    }
+    const auto reduced_points = reduce_modulo(points);
+    std::vector<std::vector<int64_t>> tree(4 * points.size());
+    build_subproduct_tree(tree, 1, 0, points.size(), reduced_points);
+    evaluate_tree(divide_modulo(trim(reduce_modulo(coefficients_)), tree[1]).second, tree, 1, 0, points.size(),
+                  reduced_points, values);
+    return values;
+}
+
+Polynom Polynom::interpolate(const std::vector<int64_t> &points, const std::vector<int64_t> &values) {
+    assert(points.size() == values.size());
+    if (points.empty()) {
+        return Polynom();
+    }
+    const auto count = points.size();
+    const auto reduced_points = reduce_modulo(points);
+    std::vector<std::vector<int64_t>> tree(4 * count);
+    build_subproduct_tree(tree, 1, 0, count, reduced_points);
+
+    // M'(x_i) = prod(x_i - x_j, j != i) - знаменатели в формуле Лагранжа
+    std::vector<int64_t> derivative(count);
+    for (size_t i = 1; i < tree[1].size(); ++i) {
+        derivative[i - 1] = tree[1][i] * static_cast<int64_t>(i) % modulus;
+    }
+    std::vector<int64_t> denominators(count);
+    evaluate_tree(derivative, tree, 1, 0, count, reduced_points, denominators);
+    auto weights = reduce_modulo(values);
+    for (size_t i = 0; i < count; ++i) {
+        assert(denominators[i] != 0);  // точки должны быть различны
+        weights[i] = weights[i] * ntt::power(denominators[i], modulus - 2, modulus) % modulus;
+    }
+    return Polynom(trim(combine_tree(weights, tree, 1, 0, count)));
+}
+
+std::vector<int64_t> Polynom::combine_tree(const std::vector<int64_t> &weights,
+                                           const std::vector<std::vector<int64_t>> &tree,
+                                           size_t node, size_t begin, size_t end) {
+    if (end - begin == 1) {
+        return {weights[begin]};
+    }
+
+    // Объединение двух отрезков: P = P_left * M_right + P_right * M_left
+    const size_t middle = (begin + end) / 2;
+    auto left = multiply_modulo(combine_tree(weights, tree, 2 * node, begin, middle), tree[2 * node + 1]);
+    auto right = multiply_modulo(combine_tree(weights, tree, 2 * node + 1, middle, end), tree[2 * node]);
+    left.resize(std::max(left.size(), right.size()), 0);
+    for (size_t i = 0; i < right.size(); ++i) {
+        left[i] = (left[i] + right[i]) % modulus;
+    }
+    return left;
+}
+
+/**
+ * @brief Класс, объединяющий работы с длинными целыми числами.
+ * @details Модуль числа хранится многочленом, коэффициенты которого - цифры в системе счисления 10^4
+ * (от младших к старшим, без ведущих нулей; у нуля коэффициентов нет), знак хранится отдельно.
+ * Деление сводится к умножению на обратное число, найденное итерациями Ньютона,
+ * поэтому все операции, кроме сложения и вычитания, работают за время, близкое ко времени умножения.
+ */
+class LongInt {
+public:
+    LongInt() = default;
+
+    /**
+     * @brief Построить объект длинного числа из целого числа.
+     * @param number Число.
+     */
+    explicit LongInt(int64_t number) : is_negative_(number < 0) {
+        // модуль считаем в беззнаковом типе, чтобы не переполниться на минимальном значении int64_t
+        auto magnitude = number < 0 ? -static_cast<uint64_t>(number) : static_cast<uint64_t>(number);
+        std::vector<int64_t> limbs;
+        for (; magnitude != 0; magnitude /= base_) {
+            limbs.push_back(static_cast<int64_t>(magnitude % base_));
+        }
+        polynom_ = Polynom(std::move(limbs));
+    }
+
+    /**
+     * @brief Построить объект длинного числа из строчного представления числа.
+     * @param number Число, записанное в строке. Может начинаться со знака '-'.
+     * @param radix Основание системы счисления, от 2 до 36. Цифры больше 9 записываются латинскими буквами.
+     */
+    explicit LongInt(const std::string &number, uint32_t radix = 10);
+
+    /**
+     * @brief Записать число в строку.
+     * @param radix Основание системы счисления, от 2 до 36. Цифры больше 9 записываются строчными латинскими буквами.
+     * @return Строчное представление числа.
+     */
+    std::string to_string(uint32_t radix = 10) const;
+
+    /**
+     * @brief Напечатать число в поток.
+     * @param stream Поток вывода.
+     */
+    void print(std::ostream &stream = std::cout) const {
+        stream << to_string() << std::endl;
+    }
+
+    /**
+     * @brief Проверить, равно ли число нулю.
+     */
+    bool is_zero() const {
+        return limbs().empty();
+    }
+
+    /**
+     * @brief Проверить, отрицательно ли число.
+     */
+    bool is_negative() const {
+        return is_negative_;
+    }
+
+    // сравнения
+    bool operator==(const LongInt &rhs) const {
+        return is_negative_ == rhs.is_negative_ && limbs() == rhs.limbs();
+    }
+
+    bool operator!=(const LongInt &rhs) const {
+        return !(*this == rhs);
+    }
+
+    bool operator<(const LongInt &rhs) const {
+        if (is_negative_ != rhs.is_negative_) {
+            return is_negative_;
+        }
+        auto comparison = compare_magnitudes(limbs(), rhs.limbs());
+        return is_negative_ ? comparison > 0 : comparison < 0;
+    }
+
+    bool operator>(const LongInt &rhs) const {
+        return rhs < *this;
+    }
+
+    bool operator<=(const LongInt &rhs) const {
+        return !(rhs < *this);
+    }
+
+    bool operator>=(const LongInt &rhs) const {
+        return !(*this < rhs);
+    }
+
+    /**
+     * @brief Смена знака.
+     * @return Число с противоположным знаком.
+     */
+    LongInt operator-() const {
+        LongInt result = *this;
+        result.is_negative_ = !is_negative_ && !is_zero();
+        return result;
+    }
+
+    /**
+     * @brief Сложение длинных чисел.
+     * @param rhs Второе слагаемое.
+     * @return Сумма.
+     */
+    LongInt operator+(const LongInt &rhs) const;
+
+    /**
+     * @brief Вычитание длинных чисел.
+     * @param rhs Вычитаемое.
+     * @return Разность.
+     */
+    LongInt operator-(const LongInt &rhs) const {
+        return *this + (-rhs);
+    }
+
+    /**
+     * @brief Умножение длинных чисел.
+     * @param rhs Второй множитель.
+     * @return Результат произведения.
+     */
+    LongInt operator*(const LongInt &rhs) const {
+        if (is_zero() || rhs.is_zero()) {
+            return LongInt();
+        }
+        return from_limbs((polynom_ * rhs.polynom_).get_coefficients(), is_negative_ != rhs.is_negative_);
+    }
+
+    /**
+     * @brief Целочисленное деление. Частное округляется к нулю, как у встроенных целых типов.
+     * @param rhs Делитель. Не равен нулю.
+     * @return Частное.
+     */
+    LongInt operator/(const LongInt &rhs) const {
+        return divide(rhs).first;
+    }
+
+    /**
+     * @brief Остаток от деления. Знак остатка совпадает со знаком делимого, как у встроенных целых типов.
+     * @param rhs Делитель. Не равен нулю.
+     * @return Остаток.
+     */
+    LongInt operator%(const LongInt &rhs) const {
+        return divide(rhs).second;
+    }
+
+    /**
+     * @brief Деление с остатком.
+     * @param rhs Делитель. Не равен нулю.
+     * @return Пара: частное, округлённое к нулю, и остаток со знаком делимого.
+     */
+    std::pair<LongInt, LongInt> divide(const LongInt &rhs) const;
+
+    /**
+     * @brief Возведение в степень.
+     * @param exponent Показатель степени.
+     * @return Степень числа.
+     */
+    LongInt pow(uint64_t exponent) const;
+
+    /**
+     * @brief Возведение в степень по модулю.
+     * @details Обратное к модулю число находится один раз, поэтому каждое взятие остатка стоит
+     * двух умножений, как в редукции Барретта.
+     * @param exponent Показатель степени. Неотрицательный.
+     * @param modulus Модуль. Положительный.
+     * @return Степень числа по модулю, от 0 до modulus - 1.
+     */
+    LongInt pow_mod(const LongInt &exponent, const LongInt &modulus) const;
+
+private:
+    // количество десятичных цифр в одном коэффициенте многочлена, то есть число хранится в системе счисления 10^4;
+    // при большем основании коэффициенты произведения миллионов цифр не округляются точно после fft
+    static constexpr size_t digits_ = 4;
+    static constexpr int64_t base_ = 10000;
+    // делители не длиннее стольких цифр делим "в столбик", длинные - умножением на обратное число
+    static constexpr size_t newton_threshold = 32;
+    // числа не длиннее стольких цифр переводим в другую систему счисления непосредственно, через int64_t
+    static constexpr size_t direct_conversion_limbs = 4;
+
+    const std::vector<int64_t> &limbs() const {
+        return polynom_.get_coefficients();
+    }
+
+    /**
+     * @brief Построить число по цифрам.
+     * @param limbs Неотрицательные цифры от младших к старшим. Могут превышать основание, лишнее переносится.
+     * @param is_negative Знак числа.
+     * @return Число.
+     */
+    static LongInt from_limbs(std::vector<int64_t> limbs, bool is_negative);
+
+    /**
+     * @brief Сравнить модули чисел.
+     * @return Отрицательное число, ноль или положительное число, если lhs меньше, равно или больше rhs.
+     */
+    static int compare_magnitudes(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs);
+
+    /**
+     * @brief Сумма модулей.
+     */
+    static std::vector<int64_t> add_magnitudes(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs);
+
+    /**
+     * @brief Разность модулей. Уменьшаемое не меньше вычитаемого.
+     */
+    static std::vector<int64_t> subtract_magnitudes(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs);
+
+    /**
+     * @brief Умножить число на степень основания, то есть дописать младшие нулевые цифры.
+     * @param count Количество цифр.
+     * @return Результат сдвига.
+     */
+    LongInt shift_left(size_t count) const;
+
+    /**
+     * @brief Разделить модуль числа на степень основания, отбросив младшие цифры. Знак сохраняется.
+     * @param count Количество цифр.
+     * @return Результат сдвига.
+     */
+    LongInt shift_right(size_t count) const;
 
-        return samples;
-    }
+    /**
+     * @brief Деление неотрицательных чисел "в столбик".
+     * @details Каждая цифра частного подбирается двоичным поиском.
+     * @param dividend Делимое.
+     * @param divisor Делитель.
+     * @return Пара: частное и остаток.
+     */
+    static std::pair<LongInt, LongInt> divide_schoolbook(const LongInt &dividend, const LongInt &divisor);
 
-private:
-    fft() = default;  // запретим создание экзампляров класса
+    /**
+     * @brief Приближённое обратное число: floor(B^(2n) / divisor), где B - основание, n - количество цифр делителя.
+     * @details Итерации Ньютона с удвоением точности: обратное к старшей половине цифр делителя уточняется
+     * одной итерацией x = x + x * (B^(2n) - divisor * x) / B^(2n), которая удваивает количество верных цифр.
+     * Результат может отличаться от точного на несколько единиц.
+     * @param divisor Положительный делитель.
+     * @return Приближённое обратное число.
+     */
+    static LongInt reciprocal(const LongInt &divisor);
 
     /**
-     * @brief Дополнить последовательность отсчётов до длины равной степени двойки.
-     * @param samples Последовательность отсчётов.
+     * @brief Деление неотрицательного числа на положительное с известным обратным числом.
+     * @details Делимое должно содержать не больше 2n цифр, где n - количество цифр делителя.
+     * @param dividend Делимое.
+     * @param divisor Делитель.
+     * @param inverse Результат reciprocal(divisor).
+     * @return Пара: частное и остаток.
      */
-    static void pad(std::vector<std::complex<double>> &samples);
+    static std::pair<LongInt, LongInt>
+    divide_by_reciprocal(const LongInt &dividend, const LongInt &divisor, const LongInt &inverse);
 
     /**
-     * @brief Определяет наименьшую степень двойки, не меньшую заданного числа.
-     * @details Используется знание о представлении чисел с плавающей точкой в памяти.
-     * @details Подробнее: https://ru.wikipedia.org/wiki/Число_двойной_точности
-     * @param number Число, которое нужно округлить вверх до степени двойки.
-     * @return Число, равное степени двойки. Минимальное, но не меньше, чем number.
+     * @brief Деление неотрицательного числа на положительное.
+     * @return Пара: частное и остаток.
      */
-    static size_t round_pow2(size_t number);
+    static std::pair<LongInt, LongInt> divide_magnitudes(const LongInt &dividend, const LongInt &divisor);
 
     /**
-     * @brief Поразрядно-обратная перестановка элементов. Bit-reversal permutation.
-     * @details В позиции i каждого элемента a[i] инвертируем порядок битов, и переупорядочим элементы массива в соответствии с новыми индексами.
-     * @param samples Массив отсчётов сигнала или спектра.
-     * @return Результат поразрядно-обратной перестановки элементов.
+     * @brief Степени основания системы счисления: radix^(2^k), пока они не превзойдут limit.
+     * @details Используются для перевода между системами счисления методом "разделяй и властвуй".
+     * @param radix Основание системы счисления.
+     * @param limit Граница.
+     * @return Степени radix^1, radix^2, radix^4, ...
      */
-    static std::vector<std::complex<double>> sort_by_reverse_index(const std::vector<std::complex<double>> &samples);
+    static std::vector<LongInt> radix_powers(uint32_t radix, const LongInt &limit);
 
     /**
-     * @brief Инвертировать порядок бит в числе.
-     * @tparam NumberType2 Тип данных числа.
-     * @param input Число.
-     * @return Число с обратным порядком бит.
+     * @brief Обратные числа к степеням основания, на которые делит to_radix.
+     * @details На одном уровне рекурсии все числа делятся на одну и ту же степень,
+     * поэтому обратное к ней вычисляется один раз, а не при каждом делении.
+     * @param powers Степени radix^(2^k).
+     * @return reciprocal(powers[k]) для всех степеней, кроме последней; пустое число для коротких степеней,
+     * на которые выгоднее делить "в столбик".
      */
-    template<typename NumberType2>
-    static NumberType2 reverse_bits(NumberType2 input);
+    static std::vector<LongInt> radix_reciprocals(const std::vector<LongInt> &powers);
 
     /**
-     * @brief Инвертировать порядок байт в числе.
-     * @tparam NumberType2 Тип данных числа.
-     * @param input Число.
-     * @return Число с обратным порядком байт.
+     * @brief Перевести неотрицательное число в систему счисления radix.
+     * @details Число делится с остатком на radix^(2^level): частное и остаток переводятся рекурсивно.
+     * @param number Число, меньшее powers[level].
+     * @param radix Основание системы счисления.
+     * @param level Уровень рекурсии.
+     * @param powers Степени radix^(2^k).
+     * @param inverses Результат radix_reciprocals(powers).
+     * @param pad Дополнять ли результат ведущими нулями до 2^level цифр.
+     * @param result Строка, в конец которой дописываются цифры.
      */
-    template<typename NumberType2>
-    static NumberType2 reverse_bytes(NumberType2 input);
-};
+    static void to_radix(const LongInt &number, uint32_t radix, size_t level, const std::vector<LongInt> &powers,
+                         const std::vector<LongInt> &inverses, bool pad, std::string &result);
 
+    /**
+     * @brief Прочитать неотрицательное число в системе счисления radix.
+     * @details Младшие 2^level цифр и остальные цифры читаются рекурсивно, затем старшая часть
+     * умножается на radix^(2^level) и складывается с младшей.
+     * @param digits Цифры числа.
+     * @param radix Основание системы счисления.
+     * @param powers Степени radix^(2^k), при необходимости дополняются.
+     * @return Число.
+     */
+    static LongInt from_radix(std::string_view digits, uint32_t radix, std::vector<LongInt> &powers);
 
-std::vector<std::complex<double>> fft::sort_by_reverse_index(const std::vector<std::complex<double>> &samples) {
-    // Найдём нужную перестановку.
-    std::vector<size_t> indexes(samples.size());
-    size_t i = 0;
-    std::iota(indexes.begin(), indexes.end(), i++);
-    sort(indexes.begin(), indexes.end(), [&](size_t i, size_t j) { return reverse_bits(i) < reverse_bits(j); });
+    Polynom polynom_;
+    bool is_negative_{false};
+};
 
-    // Пересортируем элементы
-    std::vector<std::complex<double>> result;
-    result.reserve(samples.size());
-    for (auto idx: indexes) {
-        result.push_back(samples[idx]);
+LongInt::LongInt(const std::string &number, uint32_t radix) {
+    assert(radix >= 2 && radix <= 36);
+    const bool has_sign = !number.empty() && (number[0] == '-' || number[0] == '+');
+    if (radix == 10) {
+        // основание хранения - степень десяти, поэтому десятичную запись достаточно разбить на группы цифр
+        *this = from_limbs(Polynom(number, digits_).get_coefficients(), false);
+    } else {
+        std::vector<LongInt> powers;
+        *this = from_radix(std::string_view(number).substr(has_sign ? 1 : 0), radix, powers);
     }
+    is_negative_ = has_sign && number[0] == '-' && !is_zero();
+}
 
+std::string LongInt::to_string(uint32_t radix) const {
+    assert(radix >= 2 && radix <= 36);
+    std::string result = is_negative_ ? "-" : "";
+    if (radix == 10) {
+        return result + polynom_.to_string_number(digits_);
+    }
+    if (is_zero()) {
+        return "0";
+    }
+    auto magnitude = is_negative_ ? -*this : *this;
+    auto powers = radix_powers(radix, magnitude);
+    to_radix(magnitude, radix, powers.size() - 1, powers, radix_reciprocals(powers), false, result);
     return result;
 }
 
-size_t fft::round_pow2(size_t number) {
-    double x = static_cast<double>(number - 1);  // если убрать "- 1", то "не меньше" в описании нужно заменить на "больше"
-    auto answer = reinterpret_cast<unsigned int *>(&x);
-    ++answer;
-    return static_cast<size_t>(1) << (((*answer & 0x7FF00000) >> 20) - 1022);
+LongInt LongInt::from_limbs(std::vector<int64_t> limbs, bool is_negative) {
+    int64_t carry = 0;
+    for (auto &limb: limbs) {
+        limb += carry;
+        carry = limb / base_;
+        limb %= base_;
+    }
+    for (; carry != 0; carry /= base_) {
+        limbs.push_back(carry % base_);
+    }
+    while (!limbs.empty() && limbs.back() == 0) {
+        limbs.pop_back();
+    }
+    LongInt result;
+    result.is_negative_ = is_negative && !limbs.empty();
+    result.polynom_ = Polynom(std::move(limbs));
+    return result;
 }
 
-void fft::pad(std::vector<std::complex<double>> &samples) {
-    size_t new_size = round_pow2(samples.size());
-    samples.resize(new_size);
+int LongInt::compare_magnitudes(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs) {
+    if (lhs.size() != rhs.size()) {
+        return lhs.size() < rhs.size() ? -1 : 1;
+    }
+    for (size_t i = lhs.size(); i > 0; --i) {
+        if (lhs[i - 1] != rhs[i - 1]) {
+            return lhs[i - 1] < rhs[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
 }
 
-template<typename NumberType2>
-NumberType2 fft::reverse_bits(NumberType2 input) {
-    auto result = reverse_bytes(input);
-    for (size_t i = 0; i < sizeof(NumberType2); ++i) {
-        *(reinterpret_cast<uint8_t *>(&result) + i) = reverse_bits(*(reinterpret_cast<uint8_t *>(&result) + i));
+std::vector<int64_t> LongInt::add_magnitudes(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs) {
+    std::vector<int64_t> result(std::max(lhs.size(), rhs.size()));
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = (i < lhs.size() ? lhs[i] : 0) + (i < rhs.size() ? rhs[i] : 0);
     }
     return result;
 }
 
-template<typename NumberType2>
-NumberType2 fft::reverse_bytes(NumberType2 input) {
-    NumberType2 result{0};
-    auto len = sizeof(NumberType2);
-    for (size_t i = 0; i < len / 2; ++i) {
-        std::swap(*(reinterpret_cast<uint8_t *>(&result) + i),
-                  *(reinterpret_cast<uint8_t *>(&result) + len - 1 - i));
+std::vector<int64_t> LongInt::subtract_magnitudes(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs) {
+    std::vector<int64_t> result(lhs);
+    int64_t borrow = 0;
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] -= borrow + (i < rhs.size() ? rhs[i] : 0);
+        borrow = result[i] < 0 ? 1 : 0;
+        result[i] += borrow * base_;
     }
+    assert(borrow == 0);
     return result;
 }
 
-template<>
-uint32_t fft::reverse_bytes<uint32_t>(uint32_t input) {
-    return ((input >> 24) & 0x000000FF) | ((input >> 8) & 0x0000FF00) | ((input << 8) & 0x00FF0000) |
-           ((input << 24) & 0xFF000000);
+LongInt LongInt::operator+(const LongInt &rhs) const {
+    if (is_negative_ == rhs.is_negative_) {
+        return from_limbs(add_magnitudes(limbs(), rhs.limbs()), is_negative_);
+    }
+    // при разных знаках из большего модуля вычитаем меньший, знак берём у числа с большим модулем
+    if (compare_magnitudes(limbs(), rhs.limbs()) >= 0) {
+        return from_limbs(subtract_magnitudes(limbs(), rhs.limbs()), is_negative_);
+    }
+    return from_limbs(subtract_magnitudes(rhs.limbs(), limbs()), rhs.is_negative_);
 }
 
-template<>
-uint64_t fft::reverse_bytes<uint64_t>(uint64_t input) {
-    uint64_t result = 0;
-    result |= reverse_bytes(static_cast<uint32_t>(input >> 32));
-    result |= static_cast<uint64_t>(reverse_bytes(static_cast<uint32_t>(input))) << 32;
-    return result;
+LongInt LongInt::shift_left(size_t count) const {
+    if (is_zero()) {
+        return *this;
+    }
+    std::vector<int64_t> result(count, 0);
+    result.insert(result.end(), limbs().begin(), limbs().end());
+    return from_limbs(std::move(result), is_negative_);
 }
 
-template<>
-uint8_t fft::reverse_bits<uint8_t>(uint8_t input) {
-    static const uint8_t table[] = {
-            0x00, 0x80, 0x40, 0xc0, 0x20, 0xa0, 0x60, 0xe0,
-            0x10, 0x90, 0x50, 0xd0, 0x30, 0xb0, 0x70, 0xf0,
-            0x08, 0x88, 0x48, 0xc8, 0x28, 0xa8, 0x68, 0xe8,
-            0x18, 0x98, 0x58, 0xd8, 0x38, 0xb8, 0x78, 0xf8,
-            0x04, 0x84, 0x44, 0xc4, 0x24, 0xa4, 0x64, 0xe4,
-            0x14, 0x94, 0x54, 0xd4, 0x34, 0xb4, 0x74, 0xf4,
-            0x0c, 0x8c, 0x4c, 0xcc, 0x2c, 0xac, 0x6c, 0xec,
-            0x1c, 0x9c, 0x5c, 0xdc, 0x3c, 0xbc, 0x7c, 0xfc,
-            0x02, 0x82, 0x42, 0xc2, 0x22, 0xa2, 0x62, 0xe2,
-            0x12, 0x92, 0x52, 0xd2, 0x32, 0xb2, 0x72, 0xf2,
-            0x0a, 0x8a, 0x4a, 0xca, 0x2a, 0xaa, 0x6a, 0xea,
-            0x1a, 0x9a, 0x5a, 0xda, 0x3a, 0xba, 0x7a, 0xfa,
-            0x06, 0x86, 0x46, 0xc6, 0x26, 0xa6, 0x66, 0xe6,
-            0x16, 0x96, 0x56, 0xd6, 0x36, 0xb6, 0x76, 0xf6,
-            0x0e, 0x8e, 0x4e, 0xce, 0x2e, 0xae, 0x6e, 0xee,
-            0x1e, 0x9e, 0x5e, 0xde, 0x3e, 0xbe, 0x7e, 0xfe,
-            0x01, 0x81, 0x41, 0xc1, 0x21, 0xa1, 0x61, 0xe1,
-            0x11, 0x91, 0x51, 0xd1, 0x31, 0xb1, 0x71, 0xf1,
-            0x09, 0x89, 0x49, 0xc9, 0x29, 0xa9, 0x69, 0xe9,
-            0x19, 0x99, 0x59, 0xd9, 0x39, 0xb9, 0x79, 0xf9,
-            0x05, 0x85, 0x45, 0xc5, 0x25, 0xa5, 0x65, 0xe5,
-            0x15, 0x95, 0x55, 0xd5, 0x35, 0xb5, 0x75, 0xf5,
-            0x0d, 0x8d, 0x4d, 0xcd, 0x2d, 0xad, 0x6d, 0xed,
-            0x1d, 0x9d, 0x5d, 0xdd, 0x3d, 0xbd, 0x7d, 0xfd,
-            0x03, 0x83, 0x43, 0xc3, 0x23, 0xa3, 0x63, 0xe3,
-            0x13, 0x93, 0x53, 0xd3, 0x33, 0xb3, 0x73, 0xf3,
-            0x0b, 0x8b, 0x4b, 0xcb, 0x2b, 0xab, 0x6b, 0xeb,
-            0x1b, 0x9b, 0x5b, 0xdb, 0x3b, 0xbb, 0x7b, 0xfb,
-            0x07, 0x87, 0x47, 0xc7, 0x27, 0xa7, 0x67, 0xe7,
-            0x17, 0x97, 0x57, 0xd7, 0x37, 0xb7, 0x77, 0xf7,
-            0x0f, 0x8f, 0x4f, 0xcf, 0x2f, 0xaf, 0x6f, 0xef,
-            0x1f, 0x9f, 0x5f, 0xdf, 0x3f, 0xbf, 0x7f, 0xff,
-    };
-    return table[input];
+LongInt LongInt::shift_right(size_t count) const {
+    if (count >= limbs().size()) {
+        return LongInt();
+    }
+    return from_limbs({limbs().begin() + count, limbs().end()}, is_negative_);
 }
 
-/**
- * @brief Класс, описывающий многочлен с целочисленными коэффициентами.
- */
-class Polynom {
-public:
-    Polynom() = default;
-
-    /**
-     * @brief Конструирует многочлен из набора коэффициентов.
-     * @param coefficients Массив коэффициентов. Первый - свободный член. Последний - коэффициент при максимальной степени x.
-     */
-    explicit Polynom(std::vector<int64_t> coefficients) : coefficients_(std::move(coefficients)) {}
+std::pair<LongInt, LongInt> LongInt::divide_schoolbook(const LongInt &dividend, const LongInt &divisor) {
+    const auto &divisor_limbs = divisor.limbs();
+    auto multiply = [&divisor_limbs](int64_t digit) {
+        std::vector<int64_t> product(divisor_limbs.size() + 1);
+        int64_t carry = 0;
+        for (size_t i = 0; i < divisor_limbs.size(); ++i) {
+            carry += divisor_limbs[i] * digit;
+            product[i] = carry % base_;
+            carry /= base_;
+        }
+        product.back() = carry;
+        while (!product.empty() && product.back() == 0) {
+            product.pop_back();
+        }
+        return product;
+    };
 
-    /**
-     * @brief Представляет число в виде многочлена.
-     * @tparam IntegerType Тип данных числа.
-     * @param number Целое число.
-     * @param base Основание системы счисления.
-     */
-    template<typename IntegerType>
-    explicit Polynom(IntegerType number, int16_t base = 10) {
-        while (number != 0) {
-            coefficients_.emplace_back(number % base);
-            number /= base;
+    std::vector<int64_t> quotient(dividend.limbs().size());
+    std::vector<int64_t> remainder;
+    for (size_t i = dividend.limbs().size(); i > 0; --i) {
+        // остаток = остаток * B + очередная цифра делимого
+        remainder.insert(remainder.begin(), dividend.limbs()[i - 1]);
+        while (!remainder.empty() && remainder.back() == 0) {
+            remainder.pop_back();
+        }
+        // наибольшая цифра, произведение делителя на которую не превосходит остатка
+        int64_t low = 0, high = base_ - 1;
+        while (low < high) {
+            auto middle = (low + high + 1) / 2;
+            if (compare_magnitudes(multiply(middle), remainder) <= 0) {
+                low = middle;
+            } else {
+                high = middle - 1;
+            }
+        }
+        quotient[i - 1] = low;
+        remainder = subtract_magnitudes(remainder, multiply(low));
+        while (!remainder.empty() && remainder.back() == 0) {
+            remainder.pop_back();
         }
     }
+    return {from_limbs(std::move(quotient), false), from_limbs(std::move(remainder), false)};
+}
 
-    /**
-     * @brief Представляет длинное число в виде многочлена.
-     * @details Основание системы счисления == 10.
-     * @param number Число, записанное в строке.
+LongInt LongInt::reciprocal(const LongInt &divisor) {
+    const size_t n = divisor.limbs().size();
+    const auto power = LongInt(1).shift_left(2 * n);  // B^(2n)
+    if (n <= newton_threshold) {
+        return divide_schoolbook(power, divisor).first;
+    }
+    /*
+     * Обратное к старшим k цифрам делителя, сдвинутое на n - k цифр, приближает B^(2n) / divisor
+     * с точностью примерно до k - 1 старших цифр. Итерация Ньютона удваивает это количество,
+     * поэтому пара дополнительных цифр сверх половины даёт ошибку в несколько единиц.
      */
-    explicit Polynom(const std::string &number) {
-        auto end = number.rend();
-        if (!std::isdigit(number[0])) {
-            std::advance(end, -1);
-        }
-        std::transform(number.rbegin(), end, std::back_inserter(coefficients_), [](const auto &c) {
-            return static_cast<int64_t>(c - '0');
-        });
+    const size_t k = n / 2 + 2;
+    auto x = reciprocal(divisor.shift_right(n - k)).shift_left(n - k);
+    auto error = power - divisor * x;
+    return x + (x * error).shift_right(2 * n);
+}
+
+std::pair<LongInt, LongInt>
+LongInt::divide_by_reciprocal(const LongInt &dividend, const LongInt &divisor, const LongInt &inverse) {
+    const size_t n = divisor.limbs().size();
+    assert(dividend.limbs().size() <= 2 * n);
+    auto quotient = (dividend * inverse).shift_right(2 * n);
+    auto remainder = dividend - quotient * divisor;
+    // приближённое обратное число даёт частное с ошибкой в несколько единиц, исправляем её
+    const LongInt one(1);
+    while (remainder.is_negative()) {
+        quotient = quotient - one;
+        remainder = remainder + divisor;
     }
+    while (remainder >= divisor) {
+        quotient = quotient + one;
+        remainder = remainder - divisor;
+    }
+    return {quotient, remainder};
+}
 
-    /**
-     * @brief Вычислить значение многочлена.
-     * @param x Значение x. Аргумент многочлена. Точка, в которой вычисляем значение.
-     * @return Значение многочлена.
+std::pair<LongInt, LongInt> LongInt::divide_magnitudes(const LongInt &dividend, const LongInt &divisor) {
+    if (compare_magnitudes(dividend.limbs(), divisor.limbs()) < 0) {
+        return {LongInt(), dividend};
+    }
+    const size_t n = divisor.limbs().size(), m = dividend.limbs().size();
+    if (n <= newton_threshold) {
+        return divide_schoolbook(dividend, divisor);
+    }
+    /*
+     * Обратное число позволяет делить числа не длиннее 2n цифр.
+     * Более длинное делимое и делитель умножаем на одну и ту же степень основания:
+     * частное не изменится, а остаток умножится на неё же.
      */
-    int64_t calculate_value(int64_t x) const {
-        int64_t result = 0;
-        for (auto iter = coefficients_.rbegin(); iter != coefficients_.rend(); ++iter) {
-            result *= x;
-            result += *iter;
-        }
-        return result;
+    const size_t shift = m > 2 * n ? m - 2 * n : 0;
+    auto scaled_divisor = divisor.shift_left(shift);
+    auto[quotient, remainder] = divide_by_reciprocal(dividend.shift_left(shift), scaled_divisor,
+                                                      reciprocal(scaled_divisor));
+    return {quotient, remainder.shift_right(shift)};
+}
+
+std::pair<LongInt, LongInt> LongInt::divide(const LongInt &rhs) const {
+    assert(!rhs.is_zero());
+    auto[quotient, remainder] = divide_magnitudes(is_negative_ ? -*this : *this, rhs.is_negative_ ? -rhs : rhs);
+    if (is_negative_ != rhs.is_negative_) {
+        quotient = -quotient;
+    }
+    if (is_negative_) {
+        remainder = -remainder;
     }
+    return {quotient, remainder};
+}
 
-    /**
-     * @brief Преобразует многочлен в длинное целое число.
-     * @details Основание системы счисления == 10.
-     * @return Строка с записанным в ней целым числом.
-     */
-    std::string to_string_number() const {
-        int16_t base = 10;
-        std::string result;
-        auto end = coefficients_.end();
-        while (*(end - 1) == 0) {
-            std::advance(end, -1);
-        }
-        int64_t shifted = 0;
-        for (auto iter = coefficients_.begin(); iter != end; ++iter) {
-            result += std::to_string((*iter + shifted) % base);
-            shifted = (*iter + shifted) / base;
+LongInt LongInt::pow(uint64_t exponent) const {
+    LongInt result(1), power = *this;
+    for (; exponent > 0; exponent >>= 1) {
+        if (exponent & 1) {
+            result = result * power;
         }
-        while (shifted != 0) {
-            result += std::to_string(shifted % base);
-            shifted /= base;
-        }
-        std::reverse(result.begin(), result.end());
-        if (result.empty()) {
-            return "0";
+        if (exponent > 1) {
+            power = power * power;
         }
-        return result;
     }
+    return result;
+}
 
-    /**
-     * @brief Умножение многочленов.
-     * @details Использует fft для умножения.
-     * @param rhs Второй множитель.
-     * @return Значение произведения.
+LongInt LongInt::pow_mod(const LongInt &exponent, const LongInt &modulus) const {
+    assert(!exponent.is_negative() && !modulus.is_negative() && !modulus.is_zero());
+    /*
+     * Остатки не превосходят модуля, значит их произведения содержат не больше 2n цифр,
+     * и для взятия остатка подходит одно и то же обратное к модулю число.
      */
-    Polynom operator*(const Polynom &rhs) {
-        /*
-         * Пусть даны два многочлена A и B.
-         * Посчитаем ДПФ для каждого из них.
-         * Что происходит при умножении многочленов? В каждой точке их значения просто перемножаются.
-         * Но это означает, что если мы перемножим спектры, просто умножив каждый элемент одного вектора на
-         * соответствующий ему элемент другого вектора, то мы получим не что иное, как ДПФ от произведения.
-         * Наконец, применяя обратное ДПФ, получаем произведение.
-         *
-         * Поэлементное умножение спектром, очевидно, требует для вычисления только O(n) операций.
-         * Таким образом, если мы научимся вычислять ДПФ и обратное ДПФ за время O(n log n),
-         * то и произведение двух полиномов (а, следовательно, и двух длинных чисел) мы сможем найти за O(n log n).
-         *
-         * Следует заметить, что, во-первых, два многочлена следует привести к одной степени
-         * (просто дополнив коэффициенты одного из них нулями).
-         * Во-вторых, в результате произведения двух многочленов степени n получается многочлен степени 2n-1.
-         */
-
-        std::vector<std::complex<double>> samples1(coefficients_.begin(), coefficients_.end()), samples2(
-                rhs.coefficients_.begin(), rhs.coefficients_.end());
-
-        size_t fft_length = samples1.size() + samples2.size() - 1;
-
-        samples1.resize(fft_length);
-        samples2.resize(fft_length);
-
-        auto spectrum1 = fft::transfrom(samples1);
-        auto spectrum2 = fft::transfrom(samples2);
-
-        std::vector<std::complex<double>> production_spectrum;
-        production_spectrum.reserve(spectrum1.size());
-        std::transform(
-                spectrum1.begin(), spectrum1.end(),
-                spectrum2.begin(),
-                std::back_inserter(production_spectrum),
-                [](const auto &lhs, const auto &rhs) {
-                    return lhs * rhs;
-                });
-        auto production_samples = fft::transfrom(production_spectrum, true);
+    const bool is_small = modulus.limbs().size() <= newton_threshold;
+    const auto inverse = is_small ? LongInt() : reciprocal(modulus);
+    auto reduce = [&](const LongInt &number) {
+        return is_small ? divide_schoolbook(number, modulus).second
+                        : divide_by_reciprocal(number, modulus, inverse).second;
+    };
 
-        std::vector<int64_t> production_coefficients;
-        production_coefficients.reserve(production_samples.size());
-        for (const auto &sample: production_samples) {
-            production_coefficients.push_back(std::llround(sample.real()));
+    auto base = *this % modulus;
+    if (base.is_negative()) {
+        base = base + modulus;
+    }
+    // двоичное возведение в степень по битам показателя, от старших к младшим
+    LongInt result = reduce(LongInt(1));
+    for (auto bit: exponent.to_string(2)) {
+        result = reduce(result * result);
+        if (bit == '1') {
+            result = reduce(result * base);
         }
-        return Polynom(production_coefficients);
     }
+    return result;
+}
 
-private:
-    std::vector<int64_t> coefficients_;
-};
-
-/**
- * @brief Класс, объединяющий работы с длинными целыми числами.
- */
-class LongInt {
-public:
-    LongInt() = default;
+std::vector<LongInt> LongInt::radix_powers(uint32_t radix, const LongInt &limit) {
+    std::vector<LongInt> powers{LongInt(static_cast<int64_t>(radix))};
+    while (compare_magnitudes(powers.back().limbs(), limit.limbs()) <= 0) {
+        powers.push_back(powers.back() * powers.back());
+    }
+    return powers;
+}
 
-    /**
-     * @brief Построить объект длинного числа из строчного представления числа.
-     * @param number Число, записанное в строке.
-     */
-    explicit LongInt(const std::string &number) : polynom_(number) {
-        if (number[0] == '-') {
-            is_negative_ = true;
+std::vector<LongInt> LongInt::radix_reciprocals(const std::vector<LongInt> &powers) {
+    std::vector<LongInt> inverses(powers.size() - 1);
+    for (size_t k = 0; k < inverses.size(); ++k) {
+        if (powers[k].limbs().size() > newton_threshold) {
+            inverses[k] = reciprocal(powers[k]);
         }
     }
+    return inverses;
+}
 
-    /**
-     * @brief Напечатать число в поток.
-     * @param stream Поток вывода.
-     */
-    void print(std::ostream &stream = std::cout) {
-        auto number = polynom_.to_string_number();
-        if (is_negative_ && (number != "0")) {
-            stream << '-';
+void LongInt::to_radix(const LongInt &number, uint32_t radix, size_t level, const std::vector<LongInt> &powers,
+                       const std::vector<LongInt> &inverses, bool pad, std::string &result) {
+    static const char symbols[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    const size_t width = static_cast<size_t>(1) << level;
+    if (number.limbs().size() <= direct_conversion_limbs) {
+        // число помещается в int64_t, переводим его непосредственно
+        int64_t value = 0;
+        for (auto iter = number.limbs().rbegin(); iter != number.limbs().rend(); ++iter) {
+            value = value * base_ + *iter;
+        }
+        std::string digits;
+        for (; value != 0; value /= radix) {
+            digits += symbols[value % radix];
         }
-        stream << number << std::endl;
+        if (pad) {
+            digits.resize(width, '0');
+        }
+        result.append(digits.rbegin(), digits.rend());
+        return;
     }
-
-    /**
-     * @brief Умножение длинных чисел.
-     * @param rhs Второй множитель.
-     * @return Результат произведения.
-     */
-    LongInt operator*(const LongInt &rhs) {
-        LongInt result;
-        result.polynom_ = polynom_ * rhs.polynom_;
-        result.is_negative_ = is_negative_ ^ rhs.is_negative_;
-        return result;
+    // number < powers[level] = powers[level - 1]^2, поэтому в нём не больше вдвое цифр, чем в делителе
+    const auto &divisor = powers[level - 1];
+    auto[high, low] = compare_magnitudes(number.limbs(), divisor.limbs()) < 0 ? std::pair(LongInt(), number)
+                      : divisor.limbs().size() <= newton_threshold ? divide_schoolbook(number, divisor)
+                      : divide_by_reciprocal(number, divisor, inverses[level - 1]);
+    if (!pad && high.is_zero()) {
+        to_radix(low, radix, level - 1, powers, inverses, false, result);
+        return;
     }
+    to_radix(high, radix, level - 1, powers, inverses, pad, result);
+    to_radix(low, radix, level - 1, powers, inverses, true, result);
+}
 
-private:
-    Polynom polynom_;
-    bool is_negative_{false};
-};
+LongInt LongInt::from_radix(std::string_view digits, uint32_t radix, std::vector<LongInt> &powers) {
+    if (digits.size() <= 8) {
+        // 36^8 < 2^63, такое число помещается в int64_t
+        int64_t value = 0;
+        for (auto symbol: digits) {
+            auto digit = std::isdigit(symbol) ? symbol - '0' : std::tolower(symbol) - 'a' + 10;
+            assert(digit >= 0 && static_cast<uint32_t>(digit) < radix);
+            value = value * radix + digit;
+        }
+        return LongInt(value);
+    }
+    // младшая часть - 2^level цифр, старшая - все остальные (хотя бы одна)
+    size_t level = 0;
+    while ((static_cast<size_t>(2) << level) < digits.size()) {
+        ++level;
+    }
+    if (powers.empty()) {
+        powers.emplace_back(static_cast<int64_t>(radix));
+    }
+    while (powers.size() <= level) {
+        powers.push_back(powers.back() * powers.back());
+    }
+    const size_t low_size = static_cast<size_t>(1) << level;
+    auto high = from_radix(digits.substr(0, digits.size() - low_size), radix, powers);
+    auto low = from_radix(digits.substr(digits.size() - low_size), radix, powers);
+    return high * powers[level] + low;
+}
 
 
 // Начало тестов
@@ -729,7 +2291,323 @@ void test_random_very_long() {
     }
 }
 
+void test_fft_naive_dft() {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> values_generator(-100, 100);
+    for (size_t size = 1; size <= 256; size <<= 1) {
+        std::vector<std::complex<double>> samples(size);
+        for (auto &sample: samples) {
+            sample = std::complex<double>(values_generator(gen), values_generator(gen));
+        }
+        auto spectrum = samples;
+        fft::get_plan(size).transform(spectrum);
+        for (size_t k = 0; k < size; ++k) {
+            std::complex<double> expected(0);
+            for (size_t j = 0; j < size; ++j) {
+                double arg = 2 * M_PI * static_cast<double>(j * k % size) / size;
+                expected += samples[j] * std::complex<double>(cos(arg), sin(arg));
+            }
+            assert(is_equal(spectrum[k].real(), expected.real(), 1e-6));
+            assert(is_equal(spectrum[k].imag(), expected.imag(), 1e-6));
+        }
+    }
+}
+
+void test_fft_plan_reuse() {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> values_generator(-1000, 1000);
+    const size_t size = 1 << 16;
+    const auto &plan = fft::get_plan(size);
+    assert(&plan == &fft::get_plan(size));
+    assert(plan.size() == size);
+    for (auto i = 0; i < 3; ++i) {
+        std::vector<std::complex<double>> samples(size);
+        for (auto &sample: samples) {
+            sample = values_generator(gen);
+        }
+        auto restored = samples;
+        plan.transform(restored);
+        plan.transform(restored, true);
+        for (size_t j = 0; j < size; ++j) {
+            assert(is_equal(restored[j].real(), samples[j].real(), 1e-6));
+            assert(is_equal(restored[j].imag(), samples[j].imag(), 1e-6));
+        }
+    }
+}
+
+void test_real_fft() {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> values_generator(-100, 100);
+    for (size_t size = 2; size <= 1024; size <<= 1) {
+        std::vector<double> samples(size);
+        std::generate(samples.begin(), samples.end(), [&]() { return values_generator(gen); });
+        std::vector<std::complex<double>> expected(samples.begin(), samples.end());
+        fft::get_plan(size).transform(expected);
+
+        const auto &plan = fft::get_real_plan(size);
+        assert(plan.size() == size);
+        std::vector<std::complex<double>> spectrum;
+        plan.transform(samples, spectrum);
+        assert(spectrum.size() == size / 2 + 1);
+        for (size_t k = 0; k < spectrum.size(); ++k) {
+            assert(is_equal(spectrum[k].real(), expected[k].real(), 1e-6));
+            assert(is_equal(spectrum[k].imag(), expected[k].imag(), 1e-6));
+        }
+
+        std::vector<double> restored;
+        plan.inverse_transform(spectrum, restored);
+        assert(restored.size() == size);
+        for (size_t i = 0; i < size; ++i) {
+            assert(is_equal(restored[i], samples[i], 1e-6));
+        }
+    }
+}
+
+void test_polynom_multiplication() {
+    std::mt19937 gen(42);
+    auto check = [&gen](size_t lhs_length, size_t rhs_length, int64_t max_value) {
+        std::uniform_int_distribution<int64_t> values_generator(-max_value, max_value);
+        std::vector<int64_t> lhs(lhs_length), rhs(rhs_length);
+        std::generate(lhs.begin(), lhs.end(), [&]() { return values_generator(gen); });
+        std::generate(rhs.begin(), rhs.end(), [&]() { return values_generator(gen); });
+        std::vector<int64_t> expected(lhs_length + rhs_length - 1);
+        for (size_t i = 0; i < lhs_length; ++i) {
+            for (size_t j = 0; j < rhs_length; ++j) {
+                expected[i + j] += lhs[i] * rhs[j];
+            }
+        }
+        assert(((Polynom(lhs) * Polynom(rhs)).get_coefficients() == expected));
+    };
+    // длины выбраны так, чтобы задействовать все алгоритмы умножения, в том числе для множителей разной длины
+    for (auto[lhs_length, rhs_length]: std::vector<std::pair<size_t, size_t>>{
+            {1, 1}, {5, 40}, {40, 40}, {100, 150}, {33, 400}, {250, 260}, {700, 900}, {3000, 50}}) {
+        check(lhs_length, rhs_length, 9999);
+    }
+    // большие коэффициенты, для которых точности fft не хватает
+    check(2000, 1500, 10000000);
+}
+
+void test_limbs() {
+    assert(Polynom(std::string("123456789"), 4).get_coefficients() == std::vector<int64_t>({6789, 2345, 1}));
+    assert(Polynom(std::string("-10000"), 4).get_coefficients() == std::vector<int64_t>({0, 1}));
+    assert(Polynom(std::vector<int64_t>{12345, 99999, 0}).to_string_number(4) == "1000002345");
+    assert(Polynom(std::vector<int64_t>{0, 0}).to_string_number(4) == "0");
+}
+
+std::string random_number(std::mt19937 &gen, size_t length) {
+    std::uniform_int_distribution<int> digits_generator(0, 9);
+    std::string number(1, static_cast<char>('1' + digits_generator(gen) % 9));
+    while (number.size() < length) {
+        number += static_cast<char>('0' + digits_generator(gen));
+    }
+    return number;
+}
+
+void test_add_subtract() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> numbers_generator(-1000000000000, 1000000000000);
+    for (auto i = 0; i < 1000; ++i) {
+        auto lhs = numbers_generator(gen), rhs = numbers_generator(gen);
+        assert((LongInt(lhs) + LongInt(rhs)).to_string() == std::to_string(lhs + rhs));
+        assert((LongInt(lhs) - LongInt(rhs)).to_string() == std::to_string(lhs - rhs));
+        assert((LongInt(lhs) < LongInt(rhs)) == (lhs < rhs));
+    }
+    LongInt big("99999999999999999999");
+    assert((big + LongInt(1)).to_string() == "100000000000000000000");
+    assert((LongInt(1) - big - LongInt(1)).to_string() == "-99999999999999999999");
+    assert((big - big).to_string() == "0");
+}
+
+void test_divide_small() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> numbers_generator(-1000000000000, 1000000000000);
+    for (auto i = 0; i < 1000; ++i) {
+        auto lhs = numbers_generator(gen), rhs = numbers_generator(gen) / (i % 7 == 0 ? 100000000 : 1);
+        if (rhs == 0) {
+            continue;
+        }
+        assert((LongInt(lhs) / LongInt(rhs)).to_string() == std::to_string(lhs / rhs));
+        assert((LongInt(lhs) % LongInt(rhs)).to_string() == std::to_string(lhs % rhs));
+    }
+}
+
+void test_divide_long() {
+    std::mt19937 gen(42);
+    // длины делителей по обе стороны от границы между делением "в столбик" и делением через обратное число
+    for (auto[quotient_length, divisor_length]: std::vector<std::pair<size_t, size_t>>{
+            {1, 1}, {50, 10}, {130, 129}, {129, 130}, {1000, 200}, {300, 1000}, {10000, 5000}, {5000, 20000}}) {
+        LongInt quotient(random_number(gen, quotient_length));
+        LongInt divisor(random_number(gen, divisor_length));
+        LongInt remainder = LongInt(random_number(gen, divisor_length + 1)) % divisor;
+        auto dividend = quotient * divisor + remainder;
+        auto[actual_quotient, actual_remainder] = dividend.divide(divisor);
+        assert(actual_quotient == quotient);
+        assert(actual_remainder == remainder);
+        assert((-dividend / divisor) == -quotient);
+        assert((-dividend % divisor) == -remainder);
+    }
+}
+
+void test_pow() {
+    assert(LongInt(2).pow(100).to_string() == "1267650600228229401496703205376");
+    assert(LongInt(-3).pow(3).to_string() == "-27");
+    assert(LongInt(12345).pow(0).to_string() == "1");
+    // малая теорема Ферма
+    LongInt prime(1000000007);
+    assert(LongInt(123456789).pow_mod(prime - LongInt(1), prime) == LongInt(1));
+    assert(LongInt(-2).pow_mod(LongInt(3), LongInt(5)) == LongInt(2));
+    // длинный модуль: сравниваем с возведением в степень без модуля
+    std::mt19937 gen(42);
+    LongInt base(random_number(gen, 300)), modulus(random_number(gen, 400));
+    assert(base.pow_mod(LongInt(37), modulus) == base.pow(37) % modulus);
+}
+
+void test_radix_conversion() {
+    assert(LongInt(255).to_string(16) == "ff");
+    assert(LongInt(-1099511627776).to_string(2) == "-1" + std::string(40, '0'));
+    assert(LongInt("-zz", 36).to_string() == "-1295");
+    assert(LongInt("0", 2).to_string(7) == "0");
+    std::mt19937 gen(42);
+    for (uint32_t radix: {2, 3, 16, 36}) {
+        LongInt number(random_number(gen, 3000));
+        auto converted = number.to_string(radix);
+        assert(LongInt(converted, radix) == number);
+        assert(LongInt("-" + converted, radix) == -number);
+    }
+    assert(LongInt(std::string(64, '1'), 2).to_string() == "18446744073709551615");
+}
+
+/**
+ * @brief Произведение многочленов по модулю "в столбик".
+ */
+std::vector<int64_t> multiply_naive_modulo(const std::vector<int64_t> &lhs, const std::vector<int64_t> &rhs) {
+    std::vector<int64_t> result(lhs.size() + rhs.size() - 1, 0);
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        for (size_t j = 0; j < rhs.size(); ++j) {
+            result[i + j] = (result[i + j] + lhs[i] * rhs[j]) % Polynom::modulus;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Значение многочлена в точке по модулю схемой Горнера.
+ */
+int64_t evaluate_naive_modulo(const std::vector<int64_t> &coefficients, int64_t x) {
+    int64_t result = 0;
+    for (auto iter = coefficients.rbegin(); iter != coefficients.rend(); ++iter) {
+        result = (result * x + *iter) % Polynom::modulus;
+    }
+    return result;
+}
+
+void test_polynom_inverse() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> values_generator(0, Polynom::modulus - 1);
+    for (size_t length: {1, 2, 7, 33, 100, 300}) {
+        std::vector<int64_t> coefficients(length);
+        std::generate(coefficients.begin(), coefficients.end(), [&]() { return values_generator(gen); });
+        coefficients[0] = 1 + values_generator(gen) % (Polynom::modulus - 1);
+        auto inverse = Polynom(coefficients).inverse(length).get_coefficients();
+        assert(inverse.size() == length);
+        auto product = multiply_naive_modulo(coefficients, inverse);
+        assert(product[0] == 1);
+        for (size_t i = 1; i < length; ++i) {
+            assert(product[i] == 0);
+        }
+    }
+}
+
+void test_polynom_divide() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> values_generator(-1000000, 1000000);
+    std::uniform_int_distribution<size_t> length_generator(1, 200);
+    for (auto i = 0; i < 30; ++i) {
+        std::vector<int64_t> dividend(length_generator(gen)), divisor(length_generator(gen));
+        std::generate(dividend.begin(), dividend.end(), [&]() { return values_generator(gen); });
+        std::generate(divisor.begin(), divisor.end(), [&]() { return values_generator(gen); });
+        divisor.back() = 1 + std::abs(divisor.back());
+        auto[quotient, remainder] = Polynom(dividend).divide(Polynom(divisor));
+        assert(remainder.get_coefficients().size() < divisor.size());
+        // dividend = divisor * quotient + remainder по модулю
+        for (auto &coefficient: divisor) {
+            coefficient = (coefficient % Polynom::modulus + Polynom::modulus) % Polynom::modulus;
+        }
+        auto restored = quotient.get_coefficients().empty()
+                        ? std::vector<int64_t>(1, 0) : multiply_naive_modulo(divisor, quotient.get_coefficients());
+        restored.resize(std::max(restored.size(), dividend.size()), 0);
+        for (size_t j = 0; j < remainder.get_coefficients().size(); ++j) {
+            restored[j] = (restored[j] + remainder.get_coefficients()[j]) % Polynom::modulus;
+        }
+        for (size_t j = 0; j < restored.size(); ++j) {
+            const auto expected = j < dividend.size() ? dividend[j] : 0;
+            assert(restored[j] == (expected % Polynom::modulus + Polynom::modulus) % Polynom::modulus);
+        }
+    }
+}
+
+void test_polynom_evaluate_interpolate() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> values_generator(0, Polynom::modulus - 1);
+    // короткие наборы точек считаются схемой Горнера, длинные - по дереву произведений
+    for (size_t count: {1, 2, 5, 64, 65, 300, 1000}) {
+        std::vector<int64_t> coefficients(count / 2 + 1), points(count), values(count);
+        std::generate(coefficients.begin(), coefficients.end(), [&]() { return values_generator(gen); });
+        std::generate(points.begin(), points.end(), [&]() { return values_generator(gen); });
+        auto evaluated = Polynom(coefficients).evaluate(points);
+        for (size_t i = 0; i < count; ++i) {
+            assert(evaluated[i] == evaluate_naive_modulo(coefficients, points[i]));
+        }
+
+        std::iota(points.begin(), points.end(), -static_cast<int64_t>(count) / 2);  // попарно различные точки
+        std::generate(values.begin(), values.end(), [&]() { return values_generator(gen); });
+        auto interpolated = Polynom::interpolate(points, values).get_coefficients();
+        assert(interpolated.size() <= count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto x = (points[i] % Polynom::modulus + Polynom::modulus) % Polynom::modulus;
+            assert(evaluate_naive_modulo(interpolated, x) == values[i]);
+        }
+    }
+}
+
+void test_fft_kernels() {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> values_generator(-1000, 1000);
+    for (size_t size = 1; size <= (1 << 12); size <<= 1) {
+        std::vector<std::complex<double>> samples(size);
+        for (auto &sample: samples) {
+            sample = std::complex<double>(values_generator(gen), values_generator(gen));
+        }
+        for (auto inverse: {false, true}) {
+            auto expected = samples;
+            fft::get_plan(size).transform(expected, inverse, fft::kernel::scalar);
+            for (auto type: {fft::kernel::sse2, fft::kernel::avx2}) {
+                if (!fft::is_supported(type)) {
+                    continue;
+                }
+                auto actual = samples;
+                fft::get_plan(size).transform(actual, inverse, type);
+                assert(actual == expected);  // векторные реализации совпадают со скалярной до бита
+            }
+        }
+    }
+}
+
 void run_all_tests() {
+    test_fft_naive_dft();
+    test_fft_plan_reuse();
+    test_fft_kernels();
+    test_real_fft();
+    test_polynom_multiplication();
+    test_limbs();
+    test_add_subtract();
+    test_divide_small();
+    test_divide_long();
+    test_pow();
+    test_radix_conversion();
+    test_polynom_inverse();
+    test_polynom_divide();
+    test_polynom_evaluate_interpolate();
     test_from_task_1();
     test_from_task_2();
     test_one_symbol();
@@ -62,6 +62,242 @@
 #include <numeric>
 #include <cctype>
 #include <utility>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <cstdint>
+
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Теоретико-числовое преобразование (NTT). Просто namespace с private-методами.
+ * @details Аналог преобразования Фурье в кольце вычетов по простому модулю вида c * 2^k + 1:
+ * вместо комплексных корней из единицы используются первообразные корни по модулю.
+ * Все вычисления целочисленные, поэтому свёртка получается точной, а не округлённой.
+ * Подробнее: https://cp-algorithms.com/algebra/fft.html#number-theoretic-transform
+ */
+class ntt {
+public:
+    /**
+     * @brief Выполнить теоретико-числовое преобразование на месте.
+     * @tparam Modulus Простой модуль вида c * 2^k + 1.
+     * @tparam Root Первообразный корень по модулю Modulus.
+     * @param values Вычеты. Длина - степень двойки, не больше 2^k.
+     * @param inverse True, если обратное преобразование, false - прямое.
+     */
+    template<uint32_t Modulus, uint32_t Root>
+    static void transform(std::vector<uint32_t> &values, bool inverse = false);
+
+    /**
+     * @brief Произвести точную свёртку двух целочисленных сигналов.
+     * @details Если коэффициенты свёртки заведомо меньше половины модуля, достаточно одного преобразования.
+     * Иначе свёртка вычисляется по трём модулям и восстанавливается по китайской теореме об остатках,
+     * что даёт точный результат для любых коэффициентов, помещающихся в 64 бита.
+     * @tparam InputType Целочисленный тип данных отсчётов входных сигналов.
+     * @tparam OutputIntegerType Целочисленный тип данных отсчётов свёртки.
+     * @param lhs Первая последовательность.
+     * @param rhs Вторая последовательность.
+     * @return Результат свёртки.
+     */
+    template<typename InputType, typename OutputIntegerType>
+    static std::vector<OutputIntegerType>
+    convolution(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs);
+
+private:
+    ntt() = default;  // запретим создание экзампляров класса
+
+    // модули вида c * 2^k + 1, для всех первообразный корень равен 3
+    static constexpr uint32_t modulus1 = 998244353;  // 119 * 2^23 + 1
+    static constexpr uint32_t modulus2 = 167772161;  // 5 * 2^25 + 1
+    static constexpr uint32_t modulus3 = 469762049;  // 7 * 2^26 + 1
+    static constexpr size_t max_length = static_cast<size_t>(1) << 23;  // ограничение первого модуля
+
+    /**
+     * @brief Возведение в степень по модулю.
+     * @param base Основание.
+     * @param exponent Показатель степени.
+     * @param modulus Модуль.
+     * @return base^exponent mod modulus.
+     */
+    static uint32_t power(uint32_t base, uint64_t exponent, uint32_t modulus);
+
+    /**
+     * @brief Свёртка по одному модулю.
+     * @tparam Modulus Простой модуль вида c * 2^k + 1.
+     * @tparam Root Первообразный корень по модулю Modulus.
+     * @param lhs Первая последовательность.
+     * @param rhs Вторая последовательность.
+     * @param size Длина преобразования, степень двойки.
+     * @return Вычеты коэффициентов свёртки, дополненные нулями до длины size.
+     */
+    template<uint32_t Modulus, uint32_t Root, typename InputType>
+    static std::vector<uint32_t>
+    convolution_modulo(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs, size_t size);
+
+    /**
+     * @brief Привести отсчёты сигнала по модулю.
+     * @tparam Modulus Модуль.
+     * @param values Отсчёты сигнала.
+     * @param size Длина результата, недостающие вычеты равны нулю.
+     * @return Неотрицательные вычеты отсчётов.
+     */
+    template<uint32_t Modulus, typename InputType>
+    static std::vector<uint32_t> reduce(const std::vector<InputType> &values, size_t size);
+};
+
+uint32_t ntt::power(uint32_t base, uint64_t exponent, uint32_t modulus) {
+    uint64_t result = 1;
+    uint64_t current = base % modulus;
+    for (; exponent > 0; exponent >>= 1) {
+        if (exponent & 1) {
+            result = result * current % modulus;
+        }
+        current = current * current % modulus;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+template<uint32_t Modulus, uint32_t Root>
+void ntt::transform(std::vector<uint32_t> &values, bool inverse) {
+    const auto n = values.size();
+    assert((n & (n - 1)) == 0 && (Modulus - 1) % n == 0);
+
+    // Поразрядно-обратная перестановка: j пробегает номера i, записанные в обратном порядке бит.
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(values[i], values[j]);
+        }
+    }
+
+    /*
+     * Стадии бабочки те же, что и в БПФ, только корень степени len из единицы - это Root^((Modulus - 1) / len).
+     * Степени корня вычисляются точно, поэтому накопление ошибки, как у комплексных чисел, здесь не грозит.
+     */
+    std::vector<uint32_t> roots(std::max<size_t>(n / 2, 1));
+    for (size_t len = 2; len <= n; len <<= 1) {
+        auto w_len = power(Root, (Modulus - 1) / len, Modulus);
+        if (inverse) {
+            w_len = power(w_len, Modulus - 2, Modulus);
+        }
+        roots[0] = 1;
+        for (size_t j = 1; j < len / 2; ++j) {
+            roots[j] = static_cast<uint64_t>(roots[j - 1]) * w_len % Modulus;
+        }
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < len / 2; ++j) {
+                uint32_t u = values[i + j];
+                auto v = static_cast<uint32_t>(static_cast<uint64_t>(values[i + j + len / 2]) * roots[j] % Modulus);
+                values[i + j] = u + v < Modulus ? u + v : u + v - Modulus;
+                values[i + j + len / 2] = u >= v ? u - v : u + Modulus - v;
+            }
+        }
+    }
+
+    // При обратном преобразовании каждый элемент делится на n, то есть умножается на обратный к n вычет.
+    if (inverse) {
+        const uint64_t n_inverse = power(static_cast<uint32_t>(n % Modulus), Modulus - 2, Modulus);
+        for (auto &value: values) {
+            value = static_cast<uint32_t>(value * n_inverse % Modulus);
+        }
+    }
+}
+
+template<uint32_t Modulus, typename InputType>
+std::vector<uint32_t> ntt::reduce(const std::vector<InputType> &values, size_t size) {
+    std::vector<uint32_t> result(size);
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto value = static_cast<int64_t>(values[i]) % static_cast<int64_t>(Modulus);
+        result[i] = static_cast<uint32_t>(value < 0 ? value + Modulus : value);
+    }
+    return result;
+}
+
+template<uint32_t Modulus, uint32_t Root, typename InputType>
+std::vector<uint32_t>
+ntt::convolution_modulo(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs, size_t size) {
+    auto values1 = reduce<Modulus>(lhs, size);
+    transform<Modulus, Root>(values1);
+    if (&lhs == &rhs) {
+        // свёртка последовательности с самой собой: достаточно одного прямого преобразования
+        for (size_t i = 0; i < size; ++i) {
+            values1[i] = static_cast<uint32_t>(static_cast<uint64_t>(values1[i]) * values1[i] % Modulus);
+        }
+    } else {
+        auto values2 = reduce<Modulus>(rhs, size);
+        transform<Modulus, Root>(values2);
+        for (size_t i = 0; i < size; ++i) {
+            values1[i] = static_cast<uint32_t>(static_cast<uint64_t>(values1[i]) * values2[i] % Modulus);
+        }
+    }
+    transform<Modulus, Root>(values1, true);
+    return values1;
+}
+
+template<typename InputType, typename OutputIntegerType>
+std::vector<OutputIntegerType> ntt::convolution(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs) {
+    if (lhs.empty() || rhs.empty()) {
+        return {};
+    }
+    const size_t conv_length = lhs.size() + rhs.size() - 1;
+    size_t size = 1;
+    while (size < conv_length) {
+        size <<= 1;
+    }
+    assert(size <= max_length);
+
+    // Оценка сверху для модуля коэффициентов свёртки.
+    auto max_abs = [](const std::vector<InputType> &values) {
+        double result = 0;
+        for (const auto &value: values) {
+            result = std::max(result, std::abs(static_cast<double>(value)));
+        }
+        return result;
+    };
+    const double bound = max_abs(lhs) * max_abs(rhs) * static_cast<double>(std::min(lhs.size(), rhs.size()));
+
+    std::vector<OutputIntegerType> result(conv_length);
+    if (bound < modulus1 / 2) {
+        // Вычеты больше половины модуля соответствуют отрицательным коэффициентам.
+        auto residues = convolution_modulo<modulus1, 3>(lhs, rhs, size);
+        for (size_t i = 0; i < conv_length; ++i) {
+            auto value = static_cast<int64_t>(residues[i]);
+            result[i] = static_cast<OutputIntegerType>(value > modulus1 / 2 ? value - modulus1 : value);
+        }
+        return result;
+    }
+
+    /*
+     * Алгоритм Гарнера: коэффициент x = x1 + x2 * m1 + x3 * m1 * m2, где 0 <= xi < mi.
+     * Цифры xi последовательно находятся из остатков r1, r2, r3 по модулям m1, m2, m3.
+     * Произведение модулей больше 2^78, поэтому любой 64-битный коэффициент восстанавливается однозначно.
+     */
+    auto residues1 = convolution_modulo<modulus1, 3>(lhs, rhs, size);
+    auto residues2 = convolution_modulo<modulus2, 3>(lhs, rhs, size);
+    auto residues3 = convolution_modulo<modulus3, 3>(lhs, rhs, size);
+    const uint64_t m1 = modulus1, m2 = modulus2, m3 = modulus3;
+    const uint64_t m1_inverse = power(modulus1 % modulus2, m2 - 2, modulus2);  // m1^-1 mod m2
+    const uint64_t m12_inverse = power(m1 * m2 % m3, m3 - 2, modulus3);  // (m1 * m2)^-1 mod m3
+    const auto m123 = static_cast<__int128>(m1 * m2) * m3;
+    for (size_t i = 0; i < conv_length; ++i) {
+        const uint64_t x1 = residues1[i];
+        const uint64_t x2 = (residues2[i] + m2 - x1 % m2) * m1_inverse % m2;
+        const uint64_t x3 = (residues3[i] + m3 - (x1 + x2 * m1) % m3) * m12_inverse % m3;
+        auto value = static_cast<__int128>(x1 + x2 * m1) + static_cast<__int128>(x3) * (m1 * m2);
+        if (value > m123 / 2) {
+            value -= m123;
+        }
+        result[i] = static_cast<OutputIntegerType>(value);
+    }
+    return result;
+}
 
 
 /**
@@ -70,63 +306,169 @@
 class fft {
 public:
     /**
-     * @brief Выполнить преобразование Фурье.
-     * @details Нерекурсивная реализация.
-     * @param samples Отсчёты сигнала, от которого берём прямое преобразование, или спектр для обратного преобразования.
-     * @param inverse True, если обратное преобразование, false - прямое.
-     * @return Спектр сигнала при прямом преобразовании, отсчёты сигнала - при обратном.
+     * @brief Реализации стадий бабочки.
+     * @details Векторные реализации обрабатывают за одну инструкцию 2 (SSE2) или 4 (AVX2) бабочки.
+     * Все реализации выполняют одни и те же операции в одном и том же порядке, поэтому дают одинаковый до бита результат.
      */
-    static std::vector<std::complex<double>>
-    transfrom(std::vector<std::complex<double>> samples, bool inverse = false) {
-        pad(samples);
-        /*
-         * Вначале к вектору a применяется поразрядно обратная перестановка, для чего вычисляется количество
-         * значащих бит (lg n) в числе n, и для каждой позиции i находится соответствующая ей позиция,
-         * битовая запись которой есть битовая запись числа i, записанная в обратном порядке.
-         * Если получившаяся в результате позиция оказалась больше i, то элементы в этих двух позициях надо обменять
-         * (если не это условие, то каждая пара обменяется дважды, и в итоге ничего не произойдёт).
+    enum class kernel {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    /**
+     * @brief Поддерживает ли процессор реализацию.
+     * @param type Реализация.
+     * @return True, если реализацию можно использовать.
+     */
+    static bool is_supported(kernel type);
+
+    /**
+     * @brief Самая быстрая реализация, которую поддерживает процессор. Определяется один раз при первом вызове.
+     */
+    static kernel best_kernel();
+
+    /**
+     * @brief План преобразования Фурье фиксированной длины.
+     * @details Хранит поразрядно-обратную перестановку и поворачивающие множители (twiddle factors),
+     * поэтому повторные преобразования одной длины не вычисляют их заново, не сортируют и не выделяют память.
+     */
+    class plan {
+    public:
+        /**
+         * @brief Построить план.
+         * @param size Длина преобразования. Должна быть степенью двойки.
          */
-        samples = sort_by_reverse_index(samples);
+        explicit plan(size_t size);
 
+        /**
+         * @brief Длина преобразования.
+         */
+        size_t size() const {
+            return reversed_.size();
+        }
+
+        /**
+         * @brief Выполнить преобразование Фурье на месте.
+         * @details Нерекурсивная реализация. На время преобразования отсчёты раскладываются в два массива:
+         * действительные и мнимые части (SoA), чтобы стадии бабочки можно было векторизовать.
+         * @param samples Отсчёты сигнала для прямого преобразования или спектр для обратного. Длина должна совпадать с длиной плана.
+         * @param inverse True, если обратное преобразование, false - прямое.
+         * @param type Реализация стадий бабочки. Должна поддерживаться процессором.
+         */
+        void transform(std::vector<std::complex<double>> &samples, bool inverse = false,
+                       kernel type = best_kernel()) const;
+
+    private:
+        std::vector<uint32_t> reversed_;  // reversed_[i] - число i с обратным порядком log(n) младших бит
         /*
-         * Мы применили поразрядно обратную перестановку элементов.
-         * Теперь выполним всю работу, выполняемую нижним уровнем рекурсии, т.е. вектор отсчётов разделим на пары
-         * элементов, для каждого применим преобразование бабочки, в результате в векторе отсчётов будут находиться
-         * результаты работы нижнего уровня рекурсии. На следующем шаге разделим вектор a на четвёрки элементов,
-         * к каждой применим преобразование бабочки, в результате получим ДПФ для каждой четвёрки.
-         * И так далее, наконец, на последнем шаге мы, получив результаты ДПФ для двух половинок вектора отсчётов,
-         * применим к ним преобразование бабочки и получим ДПФ для всего вектора отсчётов.
+         * Поворачивающие множители всех стадий подряд: для блоков длины len множители w^j = exp(2*pi*i*j/len),
+         * j = 0...len/2-1, лежат начиная с позиции len/2. Каждый множитель вычислен отдельно через cos и sin,
+         * а не накоплен умножением, поэтому ошибка округления не растёт вдоль блока.
+         * Действительные и мнимые части хранятся в отдельных массивах.
+         */
+        std::vector<double> roots_re_;
+        std::vector<double> roots_im_;
+    };
+
+    /**
+     * @brief План преобразования Фурье вещественного сигнала.
+     * @details Вещественный сигнал длины n упаковывается в комплексный сигнал длины n/2: чётные отсчёты становятся
+     * действительной частью, нечётные - мнимой. Он преобразуется планом половинной длины, после чего спектры
+     * чётных и нечётных отсчётов разделяются и объединяются последней стадией бабочки.
+     * Спектр вещественного сигнала симметричен (X[n-k] = X[k]*), поэтому хранятся только отсчёты 0...n/2.
+     * Так преобразование требует вдвое меньше вычислений и памяти, чем комплексное той же длины.
+     */
+    class real_plan {
+    public:
+        /**
+         * @brief Построить план.
+         * @param size Длина вещественного сигнала. Должна быть степенью двойки, не меньше 2.
          */
+        explicit real_plan(size_t size);
 
-        for (size_t len = 2; len <= samples.size(); len <<= 1) {
-            /*
-             * Выполняется (log(n) - 1) стадий алгоритма, на k-ой из которых (k=2...log(n)) вычисляются ДПФ для блоков
-             * длины 2^k. Для всех этих блоков будет одно и то же значение первообразного корня, которое запоминается
-             * в переменной w_current.
-             * Цикл по i итерируется по блокам,
-             * а вложенный в него цикл по j применяет преобразование бабочки ко всем элементам блока.
-             */
-            double arg = 2 * M_PI / len * (inverse ? -1 : 1);
-            std::complex<double> w_current(cos(arg), sin(arg));
-            for (int i = 0; i < samples.size(); i += len) {
-                std::complex<double> w(1);
-                for (int j = 0; j < len / 2; ++j) {
-                    std::complex<double> u = samples[i + j], v = samples[i + j + len / 2] * w;
-                    samples[i + j] = u + v;
-                    samples[i + j + len / 2] = u - v;
-                    w *= w_current;
+        /**
+         * @brief Длина вещественного сигнала.
+         */
+        size_t size() const {
+            return 2 * half_.size();
+        }
+
+        /**
+         * @brief Прямое преобразование вещественного сигнала.
+         * @tparam SampleType Тип данных отсчётов сигнала.
+         * @param samples Отсчёты сигнала. Если их меньше длины плана, сигнал дополняется нулями.
+         * @param spectrum Сюда записываются n/2 + 1 первых отсчётов спектра.
+         */
+        template<typename SampleType>
+        void transform(const std::vector<SampleType> &samples, std::vector<std::complex<double>> &spectrum) const {
+            assert(samples.size() <= size());
+            spectrum.reserve(half_.size() + 1);
+            spectrum.assign(half_.size(), 0);
+            for (size_t i = 0; i < samples.size(); ++i) {
+                if (i % 2 == 0) {
+                    spectrum[i / 2].real(static_cast<double>(samples[i]));
+                } else {
+                    spectrum[i / 2].imag(static_cast<double>(samples[i]));
                 }
             }
+            split_spectrum(spectrum);
         }
-        /*
-         * Если указан флаг inverse = true, то w_n заменяется на w_n^-1, а каждый элемент результата делится на 2
-         * (учитывая, что эти деления на 2 произойдут в каждом уровне рекурсии, то в итоге как раз получится,
-         * что все элементы поделятся на n).
+
+        /**
+         * @brief Обратное преобразование спектра вещественного сигнала.
+         * @param spectrum n/2 + 1 первых отсчётов спектра. Используется как рабочий буфер, содержимое портится.
+         * @param samples Сюда записываются n отсчётов сигнала.
          */
-        if (inverse) {
-            std::for_each(samples.begin(), samples.end(), [&samples](auto &sample) { sample /= samples.size(); });
-        }
+        void inverse_transform(std::vector<std::complex<double>> &spectrum, std::vector<double> &samples) const;
+
+    private:
+        /**
+         * @brief Получить спектр вещественного сигнала из спектра упакованного сигнала.
+         * @param spectrum Упакованный сигнал в первых n/2 отсчётах. Заменяется на n/2 + 1 отсчётов спектра.
+         */
+        void split_spectrum(std::vector<std::complex<double>> &spectrum) const;
+
+        const plan &half_;
+        std::vector<std::complex<double>> twiddles_;  // twiddles_[k] = exp(2*pi*i*k/n), k = 0...n/2-1
+    };
+
+    /**
+     * @brief Получить план преобразования заданной длины. Планы строятся один раз и переиспользуются.
+     * @details Можно вызывать из нескольких потоков: построенный план не изменяется.
+     * @param size Длина преобразования. Должна быть степенью двойки.
+     * @return План.
+     */
+    static const plan &get_plan(size_t size);
+
+    /**
+     * @brief Получить план преобразования вещественного сигнала. Планы строятся один раз и переиспользуются.
+     * @details Можно вызывать из нескольких потоков: построенный план не изменяется.
+     * @param length Длина сигнала. Округляется вверх до степени двойки, не меньшей 2.
+     * @return План.
+     */
+    static const real_plan &get_real_plan(size_t length);
+
+    /**
+     * @brief Выполнить преобразование Фурье на месте.
+     * @details Последовательность дополняется нулями до длины, равной степени двойки.
+     * @param samples Отсчёты сигнала, от которого берём прямое преобразование, или спектр для обратного преобразования.
+     * @param inverse True, если обратное преобразование, false - прямое.
+     */
+    static void transform_inplace(std::vector<std::complex<double>> &samples, bool inverse = false) {
+        pad(samples);
+        get_plan(samples.size()).transform(samples, inverse);
+    }
 
+    /**
+     * @brief Выполнить преобразование Фурье.
+     * @param samples Отсчёты сигнала, от которого берём прямое преобразование, или спектр для обратного преобразования.
+     * @param inverse True, если обратное преобразование, false - прямое.
+     * @return Спектр сигнала при прямом преобразовании, отсчёты сигнала - при обратном.
+     */
+    static std::vector<std::complex<double>>
+    transfrom(std::vector<std::complex<double>> samples, bool inverse = false) {
+        transform_inplace(samples, inverse);
         return samples;
     }
 
@@ -141,33 +483,28 @@ public:
     template<typename InputType, typename OutputIntegerType>
     static std::vector<OutputIntegerType>
     convolution(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs) {
-        std::vector<std::complex<double>> samples1(lhs.begin(), lhs.end()), samples2(rhs.begin(), rhs.end());
-
-        size_t conv_length = samples1.size() + samples2.size() - 1;
-
-        samples1.resize(conv_length);
-        samples2.resize(conv_length);
-
-        auto spectrum1 = fft::transfrom(samples1);
-        auto spectrum2 = fft::transfrom(samples2);
+        if constexpr (std::is_integral_v<InputType>) {
+            // целочисленные сигналы сворачиваем точно, без округления комплексных чисел
+            return ntt::convolution<InputType, OutputIntegerType>(lhs, rhs);
+        }
+        // вещественные сигналы сворачиваем преобразованием вещественного сигнала: оно вдвое дешевле комплексного
+        const size_t conv_length = lhs.size() + rhs.size() - 1;
+        const auto &plan = fft::get_real_plan(conv_length);
 
-        std::vector<std::complex<double>> production_spectrum;
-        production_spectrum.reserve(spectrum1.size());
-        std::transform(
-                spectrum1.begin(), spectrum1.end(),
-                spectrum2.begin(),
-                std::back_inserter(production_spectrum),
-                [](const auto &lhs, const auto &rhs) {
-                    return lhs * rhs;
-                });
-        auto production_samples = fft::transfrom(production_spectrum, true);
+        std::vector<std::complex<double>> spectrum1, spectrum2;
+        plan.transform(lhs, spectrum1);
+        plan.transform(rhs, spectrum2);
+        for (size_t i = 0; i < spectrum1.size(); ++i) {
+            spectrum1[i] *= spectrum2[i];
+        }
+        std::vector<double> production_samples;
+        plan.inverse_transform(spectrum1, production_samples);
 
         std::vector<OutputIntegerType> result;
-        result.reserve(production_samples.size());
-        for (const auto &sample: production_samples) {
-            result.emplace_back(std::llround(sample.real()));
+        result.reserve(conv_length);
+        for (size_t i = 0; i < conv_length; ++i) {
+            result.emplace_back(std::llround(production_samples[i]));
         }
-        result.resize(conv_length);
         return result;
     }
 
@@ -190,47 +527,297 @@ private:
     static size_t round_pow2(size_t number);
 
     /**
-     * @brief Поразрядно-обратная перестановка элементов. Bit-reversal permutation.
-     * @details В позиции i каждого элемента a[i] инвертируем порядок битов, и переупорядочим элементы массива в соответствии с новыми индексами.
-     * @param samples Массив отсчётов сигнала или спектра.
-     * @return Результат поразрядно-обратной перестановки элементов.
+     * @brief Все стадии бабочки для отсчётов, уже переставленных в поразрядно-обратном порядке.
+     * @param re Действительные части отсчётов.
+     * @param im Мнимые части отсчётов.
+     * @param n Количество отсчётов, степень двойки.
+     * @param roots_re Действительные части поворачивающих множителей плана.
+     * @param roots_im Мнимые части поворачивающих множителей плана.
+     * @param sign 1 для прямого преобразования, -1 для обратного (множители заменяются сопряжёнными).
      */
-    static std::vector<std::complex<double>> sort_by_reverse_index(const std::vector<std::complex<double>> &samples);
+    static void butterflies_scalar(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                                   double sign);
+#if defined(__x86_64__) || defined(__i386__)
+    static void butterflies_sse2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                                 double sign);
+    static void butterflies_avx2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                                 double sign);
+#endif
 
     /**
-     * @brief Инвертировать порядок бит в числе.
-     * @tparam NumberType2 Тип данных числа.
-     * @param input Число.
-     * @return Число с обратным порядком бит.
+     * @brief Одна стадия бабочки без векторизации: для блоков длины len, начиная с позиции, кратной len.
+     * @details Используется скалярной реализацией и векторными для коротких блоков.
      */
-    template<typename NumberType2>
-    static NumberType2 reverse_bits(NumberType2 input);
+    static void stage_scalar(double *re, double *im, size_t n, size_t len, const double *roots_re,
+                             const double *roots_im, double sign) {
+        const size_t half = len / 2;
+        for (size_t i = 0; i + len <= n; i += len) {
+            for (size_t j = 0; j < half; ++j) {
+                const double w_re = roots_re[half + j], w_im = sign * roots_im[half + j];
+                const double v_re = re[i + j + half] * w_re - im[i + j + half] * w_im;
+                const double v_im = re[i + j + half] * w_im + im[i + j + half] * w_re;
+                re[i + j + half] = re[i + j] - v_re;
+                im[i + j + half] = im[i + j] - v_im;
+                re[i + j] = re[i + j] + v_re;
+                im[i + j] = im[i + j] + v_im;
+            }
+        }
+    }
+};
 
-    /**
-     * @brief Инвертировать порядок байт в числе.
-     * @tparam NumberType2 Тип данных числа.
-     * @param input Число.
-     * @return Число с обратным порядком байт.
+fft::plan::plan(size_t size)
+        : reversed_(size), roots_re_(std::max<size_t>(size, 2)), roots_im_(std::max<size_t>(size, 2)) {
+    /*
+     * Поразрядно-обратная перестановка за O(n): запись числа i в обратном порядке - это запись числа i / 2
+     * в обратном порядке, сдвинутая на один разряд, к которой слева дописан младший бит i.
      */
-    template<typename NumberType2>
-    static NumberType2 reverse_bytes(NumberType2 input);
-};
+    size_t log_size = 0;
+    while ((static_cast<size_t>(1) << log_size) < size) {
+        ++log_size;
+    }
+    for (size_t i = 1; i < size; ++i) {
+        reversed_[i] = (reversed_[i >> 1] >> 1) | ((i & 1) << (log_size - 1));
+    }
 
-std::vector<std::complex<double>> fft::sort_by_reverse_index(const std::vector<std::complex<double>> &samples) {
-    // Найдём нужную перестановку.
-    std::vector<size_t> indexes(samples.size());
-    size_t i = 0;
-    std::iota(indexes.begin(), indexes.end(), i++);
-    sort(indexes.begin(), indexes.end(), [&](size_t i, size_t j) { return reverse_bits(i) < reverse_bits(j); });
+    /*
+     * Множители последней стадии вычисляем напрямую, множители предыдущих стадий - это каждый второй,
+     * каждый четвёртый и т.д. множитель последней стадии.
+     */
+    const auto half = size / 2;
+    for (size_t j = 0; j < half; ++j) {
+        double arg = 2 * M_PI * j / size;
+        roots_re_[half + j] = cos(arg);
+        roots_im_[half + j] = sin(arg);
+    }
+    for (size_t len = half; len >= 2; len >>= 1) {
+        for (size_t j = 0; j < len / 2; ++j) {
+            roots_re_[len / 2 + j] = roots_re_[half + j * (size / len)];
+            roots_im_[len / 2 + j] = roots_im_[half + j * (size / len)];
+        }
+    }
+}
 
-    // Пересортируем элементы
-    std::vector<std::complex<double>> result;
-    result.reserve(samples.size());
-    for (auto idx: indexes) {
-        result.push_back(samples[idx]);
+void fft::plan::transform(std::vector<std::complex<double>> &samples, bool inverse, kernel type) const {
+    assert(samples.size() == size());
+    assert(is_supported(type));
+    /*
+     * Вначале к вектору a применяется поразрядно обратная перестановка:
+     * на позицию i попадает элемент с позиции, битовая запись которой есть битовая запись числа i в обратном порядке.
+     * Одновременно раскладываем отсчёты на действительные и мнимые части.
+     * Буферы свои у каждого потока и переиспользуются между вызовами.
+     */
+    thread_local std::vector<double> re, im;
+    re.resize(samples.size());
+    im.resize(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        re[i] = samples[reversed_[i]].real();
+        im[i] = samples[reversed_[i]].imag();
     }
 
-    return result;
+    /*
+     * Мы применили поразрядно обратную перестановку элементов.
+     * Теперь выполним всю работу, выполняемую нижним уровнем рекурсии, т.е. вектор отсчётов разделим на пары
+     * элементов, для каждого применим преобразование бабочки, в результате в векторе отсчётов будут находиться
+     * результаты работы нижнего уровня рекурсии. На следующем шаге разделим вектор a на четвёрки элементов,
+     * к каждой применим преобразование бабочки, в результате получим ДПФ для каждой четвёрки.
+     * И так далее, наконец, на последнем шаге мы, получив результаты ДПФ для двух половинок вектора отсчётов,
+     * применим к ним преобразование бабочки и получим ДПФ для всего вектора отсчётов.
+     * Для обратного преобразования w_n заменяется на w_n^-1, то есть на сопряжённое число.
+     */
+    const double sign = inverse ? -1.0 : 1.0;
+    switch (type) {
+#if defined(__x86_64__) || defined(__i386__)
+        case kernel::avx2:
+            butterflies_avx2(re.data(), im.data(), samples.size(), roots_re_.data(), roots_im_.data(), sign);
+            break;
+        case kernel::sse2:
+            butterflies_sse2(re.data(), im.data(), samples.size(), roots_re_.data(), roots_im_.data(), sign);
+            break;
+#endif
+        default:
+            butterflies_scalar(re.data(), im.data(), samples.size(), roots_re_.data(), roots_im_.data(), sign);
+            break;
+    }
+
+    /*
+     * При обратном преобразовании каждый элемент результата делится на n.
+     */
+    const double scale = inverse ? 1.0 / samples.size() : 1.0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = std::complex<double>(re[i] * scale, im[i] * scale);
+    }
+}
+
+bool fft::is_supported(kernel type) {
+    switch (type) {
+        case kernel::scalar:
+            return true;
+#if defined(__x86_64__) || defined(__i386__)
+        case kernel::sse2:
+            return __builtin_cpu_supports("sse2");
+        case kernel::avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+fft::kernel fft::best_kernel() {
+    static const kernel best = is_supported(kernel::avx2) ? kernel::avx2 :
+                               is_supported(kernel::sse2) ? kernel::sse2 : kernel::scalar;
+    return best;
+}
+
+void fft::butterflies_scalar(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                             double sign) {
+    for (size_t len = 2; len <= n; len <<= 1) {
+        stage_scalar(re, im, n, len, roots_re, roots_im, sign);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+ * Векторные реализации обрабатывают бабочки j, j+1, ... блока одновременно: в массивах SoA соседние
+ * действительные (и мнимые) части лежат подряд, поэтому загружаются одной инструкцией.
+ * Блоки короче ширины вектора обрабатываются скалярно. FMA не используется, чтобы результат совпадал со скалярным.
+ */
+__attribute__((target("sse2")))
+void fft::butterflies_sse2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                           double sign) {
+    stage_scalar(re, im, n, 2, roots_re, roots_im, sign);
+    const __m128d sign_vector = _mm_set1_pd(sign);
+    for (size_t len = 4; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; j += 2) {
+                const __m128d w_re = _mm_loadu_pd(roots_re + half + j);
+                const __m128d w_im = _mm_mul_pd(sign_vector, _mm_loadu_pd(roots_im + half + j));
+                const __m128d x_re = _mm_loadu_pd(re + i + j + half), x_im = _mm_loadu_pd(im + i + j + half);
+                const __m128d v_re = _mm_sub_pd(_mm_mul_pd(x_re, w_re), _mm_mul_pd(x_im, w_im));
+                const __m128d v_im = _mm_add_pd(_mm_mul_pd(x_re, w_im), _mm_mul_pd(x_im, w_re));
+                const __m128d u_re = _mm_loadu_pd(re + i + j), u_im = _mm_loadu_pd(im + i + j);
+                _mm_storeu_pd(re + i + j + half, _mm_sub_pd(u_re, v_re));
+                _mm_storeu_pd(im + i + j + half, _mm_sub_pd(u_im, v_im));
+                _mm_storeu_pd(re + i + j, _mm_add_pd(u_re, v_re));
+                _mm_storeu_pd(im + i + j, _mm_add_pd(u_im, v_im));
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void fft::butterflies_avx2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                           double sign) {
+    stage_scalar(re, im, n, 2, roots_re, roots_im, sign);
+    stage_scalar(re, im, n, 4, roots_re, roots_im, sign);
+    const __m256d sign_vector = _mm256_set1_pd(sign);
+    for (size_t len = 8; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; j += 4) {
+                const __m256d w_re = _mm256_loadu_pd(roots_re + half + j);
+                const __m256d w_im = _mm256_mul_pd(sign_vector, _mm256_loadu_pd(roots_im + half + j));
+                const __m256d x_re = _mm256_loadu_pd(re + i + j + half), x_im = _mm256_loadu_pd(im + i + j + half);
+                const __m256d v_re = _mm256_sub_pd(_mm256_mul_pd(x_re, w_re), _mm256_mul_pd(x_im, w_im));
+                const __m256d v_im = _mm256_add_pd(_mm256_mul_pd(x_re, w_im), _mm256_mul_pd(x_im, w_re));
+                const __m256d u_re = _mm256_loadu_pd(re + i + j), u_im = _mm256_loadu_pd(im + i + j);
+                _mm256_storeu_pd(re + i + j + half, _mm256_sub_pd(u_re, v_re));
+                _mm256_storeu_pd(im + i + j + half, _mm256_sub_pd(u_im, v_im));
+                _mm256_storeu_pd(re + i + j, _mm256_add_pd(u_re, v_re));
+                _mm256_storeu_pd(im + i + j, _mm256_add_pd(u_im, v_im));
+            }
+        }
+    }
+}
+
+#endif
+
+const fft::plan &fft::get_plan(size_t size) {
+    // планы храним по логарифму длины: длин, являющихся степенью двойки, немного
+    static std::vector<std::unique_ptr<plan>> plans(sizeof(size_t) * 8);
+    static std::mutex plans_mutex;  // без блокировки два потока могли бы одновременно строить план одной длины
+    size_t log_size = 0;
+    while ((static_cast<size_t>(1) << log_size) < size) {
+        ++log_size;
+    }
+    std::lock_guard<std::mutex> lock(plans_mutex);
+    if (!plans[log_size]) {
+        plans[log_size] = std::make_unique<plan>(size);
+    }
+    return *plans[log_size];
+}
+
+fft::real_plan::real_plan(size_t size) : half_(get_plan(size / 2)), twiddles_(size / 2) {
+    assert(size >= 2);
+    for (size_t k = 0; k < twiddles_.size(); ++k) {
+        double arg = 2 * M_PI * k / size;
+        twiddles_[k] = std::complex<double>(cos(arg), sin(arg));
+    }
+}
+
+void fft::real_plan::split_spectrum(std::vector<std::complex<double>> &spectrum) const {
+    using namespace std::complex_literals;
+    /*
+     * z(m) = x(2m) + i x(2m+1), Z = FFT(z) длины n/2.
+     * Спектры чётных и нечётных отсчётов: E[k] = (Z[k] + Z[n/2-k]*)/2, O[k] = -i(Z[k] - Z[n/2-k]*)/2.
+     * Спектр сигнала: X[k] = E[k] + w^k O[k], w = exp(2*pi*i/n).
+     * E и O - спектры вещественных сигналов, поэтому E[n/2-k] = E[k]*, O[n/2-k] = O[k]*,
+     * и отсчёты k и n/2-k вычисляются вместе, на месте.
+     */
+    const auto half = half_.size();
+    half_.transform(spectrum);
+    spectrum.resize(half + 1);
+    const auto z0 = spectrum[0];
+    spectrum[0] = z0.real() + z0.imag();
+    spectrum[half] = z0.real() - z0.imag();
+    for (size_t k = 1; k <= half / 2; ++k) {
+        const auto z_k = spectrum[k], z_m = std::conj(spectrum[half - k]);
+        const auto even = (z_k + z_m) / 2.0, odd = -1.0i * (z_k - z_m) / 2.0;
+        spectrum[k] = even + twiddles_[k] * odd;
+        spectrum[half - k] = std::conj(even) + twiddles_[half - k] * std::conj(odd);
+    }
+}
+
+void fft::real_plan::inverse_transform(std::vector<std::complex<double>> &spectrum, std::vector<double> &samples) const {
+    using namespace std::complex_literals;
+    /*
+     * Обратные действия: E[k] = (X[k] + X[n/2-k]*)/2, O[k] = w^-k (X[k] - X[n/2-k]*)/2,
+     * Z[k] = E[k] + i O[k], затем обратное преобразование половинной длины даёт чётные и нечётные отсчёты.
+     */
+    const auto half = half_.size();
+    assert(spectrum.size() == half + 1);
+    const auto x0 = spectrum[0].real(), x_half = spectrum[half].real();
+    spectrum[0] = std::complex<double>((x0 + x_half) / 2.0, (x0 - x_half) / 2.0);
+    for (size_t k = 1; k <= half / 2; ++k) {
+        const auto x_k = spectrum[k], x_m = std::conj(spectrum[half - k]);
+        const auto even = (x_k + x_m) / 2.0, odd = std::conj(twiddles_[k]) * (x_k - x_m) / 2.0;
+        spectrum[k] = even + 1.0i * odd;
+        spectrum[half - k] = std::conj(even) + 1.0i * std::conj(odd);
+    }
+    spectrum.resize(half);
+    half_.transform(spectrum, true);
+    samples.resize(size());
+    for (size_t m = 0; m < half; ++m) {
+        samples[2 * m] = spectrum[m].real();
+        samples[2 * m + 1] = spectrum[m].imag();
+    }
+}
+
+const fft::real_plan &fft::get_real_plan(size_t length) {
+    static std::vector<std::unique_ptr<real_plan>> plans(sizeof(size_t) * 8);
+    static std::mutex plans_mutex;
+    size_t log_size = 1;
+    while ((static_cast<size_t>(1) << log_size) < length) {
+        ++log_size;
+    }
+    // план половинной длины берётся из get_plan под другой блокировкой, поэтому взаимной блокировки нет
+    std::lock_guard<std::mutex> lock(plans_mutex);
+    if (!plans[log_size]) {
+        plans[log_size] = std::make_unique<real_plan>(static_cast<size_t>(1) << log_size);
+    }
+    return *plans[log_size];
 }
 
 size_t fft::round_pow2(size_t number) {
@@ -246,102 +833,210 @@ void fft::pad(std::vector<std::complex<double>> &samples) {
     samples.resize(new_size);
 }
 
-template<typename NumberType2>
-NumberType2 fft::reverse_bits(NumberType2 input) {
-    auto result = reverse_bytes(input);
-    for (size_t i = 0; i < sizeof(NumberType2); ++i) {
-        *(reinterpret_cast<uint8_t *>(&result) + i) = reverse_bits(*(reinterpret_cast<uint8_t *>(&result) + i));
+/**
+ * @brief Счётчик симметричных троек единиц: позиций i - d, i, i + d (d >= 1), в каждой из которых стоит единица.
+ * @details Биты хранятся упакованными по 64 в слово: в прямом и обратном порядке, а также отдельно
+ * чётные и нечётные позиции. В таких массивах пары битов на равных расстояниях от любой позиции лежат подряд,
+ * поэтому сравниваются по 64 пары за одну операцию AND с подсчётом единиц (popcount).
+ * Начальное количество для коротких последовательностей считается так за O(n^2 / 64),
+ * для длинных - через самосвёртку NTT за O(n log n).
+ * Изменение одного бита пересчитывает количество за O(n / 64).
+ */
+class triples_counter {
+public:
+    /**
+     * @brief Подсчитать симметричные тройки.
+     * @param bits Входные данные (массив true(1) и false(0)).
+     */
+    explicit triples_counter(const std::vector<bool> &bits);
+
+    /**
+     * @brief Количество битов.
+     */
+    size_t size() const {
+        return size_;
     }
-    return result;
-}
 
-template<typename NumberType2>
-NumberType2 fft::reverse_bytes(NumberType2 input) {
-    NumberType2 result{0};
-    auto len = sizeof(NumberType2);
-    for (size_t i = 0; i < len / 2; ++i) {
-        std::swap(*(reinterpret_cast<uint8_t *>(&result) + i),
-                  *(reinterpret_cast<uint8_t *>(&result) + len - 1 - i));
+    /**
+     * @brief Количество симметричных троек единиц.
+     */
+    size_t count() const {
+        return count_;
     }
-    return result;
-}
 
-template<>
-uint32_t fft::reverse_bytes<uint32_t>(uint32_t input) {
-    return ((input >> 24) & 0x000000FF) | ((input >> 8) & 0x0000FF00) | ((input << 8) & 0x00FF0000) |
-           ((input << 24) & 0xFF000000);
-}
+    /**
+     * @brief Значение бита.
+     */
+    bool get(size_t position) const {
+        return direct_.get(position);
+    }
 
-template<>
-uint64_t fft::reverse_bytes<uint64_t>(uint64_t input) {
-    uint64_t result = 0;
-    result |= reverse_bytes(static_cast<uint32_t>(input >> 32));
-    result |= static_cast<uint64_t>(reverse_bytes(static_cast<uint32_t>(input))) << 32;
-    return result;
-}
+    /**
+     * @brief Установить значение бита и пересчитать количество троек.
+     */
+    void set(size_t position, bool value) {
+        if (get(position) != value) {
+            flip(position);
+        }
+    }
+
+    /**
+     * @brief Инвертировать бит и пересчитать количество троек.
+     */
+    void flip(size_t position);
+
+    // Начиная с этой длины начальное количество считается через NTT, а не попарным сравнением
+    static constexpr size_t ntt_threshold = 1 << 13;
 
-template<>
-uint8_t fft::reverse_bits<uint8_t>(uint8_t input) {
-    static const uint8_t table[] = {
-            0x00, 0x80, 0x40, 0xc0, 0x20, 0xa0, 0x60, 0xe0,
-            0x10, 0x90, 0x50, 0xd0, 0x30, 0xb0, 0x70, 0xf0,
-            0x08, 0x88, 0x48, 0xc8, 0x28, 0xa8, 0x68, 0xe8,
-            0x18, 0x98, 0x58, 0xd8, 0x38, 0xb8, 0x78, 0xf8,
-            0x04, 0x84, 0x44, 0xc4, 0x24, 0xa4, 0x64, 0xe4,
-            0x14, 0x94, 0x54, 0xd4, 0x34, 0xb4, 0x74, 0xf4,
-            0x0c, 0x8c, 0x4c, 0xcc, 0x2c, 0xac, 0x6c, 0xec,
-            0x1c, 0x9c, 0x5c, 0xdc, 0x3c, 0xbc, 0x7c, 0xfc,
-            0x02, 0x82, 0x42, 0xc2, 0x22, 0xa2, 0x62, 0xe2,
-            0x12, 0x92, 0x52, 0xd2, 0x32, 0xb2, 0x72, 0xf2,
-            0x0a, 0x8a, 0x4a, 0xca, 0x2a, 0xaa, 0x6a, 0xea,
-            0x1a, 0x9a, 0x5a, 0xda, 0x3a, 0xba, 0x7a, 0xfa,
-            0x06, 0x86, 0x46, 0xc6, 0x26, 0xa6, 0x66, 0xe6,
-            0x16, 0x96, 0x56, 0xd6, 0x36, 0xb6, 0x76, 0xf6,
-            0x0e, 0x8e, 0x4e, 0xce, 0x2e, 0xae, 0x6e, 0xee,
-            0x1e, 0x9e, 0x5e, 0xde, 0x3e, 0xbe, 0x7e, 0xfe,
-            0x01, 0x81, 0x41, 0xc1, 0x21, 0xa1, 0x61, 0xe1,
-            0x11, 0x91, 0x51, 0xd1, 0x31, 0xb1, 0x71, 0xf1,
-            0x09, 0x89, 0x49, 0xc9, 0x29, 0xa9, 0x69, 0xe9,
-            0x19, 0x99, 0x59, 0xd9, 0x39, 0xb9, 0x79, 0xf9,
-            0x05, 0x85, 0x45, 0xc5, 0x25, 0xa5, 0x65, 0xe5,
-            0x15, 0x95, 0x55, 0xd5, 0x35, 0xb5, 0x75, 0xf5,
-            0x0d, 0x8d, 0x4d, 0xcd, 0x2d, 0xad, 0x6d, 0xed,
-            0x1d, 0x9d, 0x5d, 0xdd, 0x3d, 0xbd, 0x7d, 0xfd,
-            0x03, 0x83, 0x43, 0xc3, 0x23, 0xa3, 0x63, 0xe3,
-            0x13, 0x93, 0x53, 0xd3, 0x33, 0xb3, 0x73, 0xf3,
-            0x0b, 0x8b, 0x4b, 0xcb, 0x2b, 0xab, 0x6b, 0xeb,
-            0x1b, 0x9b, 0x5b, 0xdb, 0x3b, 0xbb, 0x7b, 0xfb,
-            0x07, 0x87, 0x47, 0xc7, 0x27, 0xa7, 0x67, 0xe7,
-            0x17, 0x97, 0x57, 0xd7, 0x37, 0xb7, 0x77, 0xf7,
-            0x0f, 0x8f, 0x4f, 0xcf, 0x2f, 0xaf, 0x6f, 0xef,
-            0x1f, 0x9f, 0x5f, 0xdf, 0x3f, 0xbf, 0x7f, 0xff,
+private:
+    /**
+     * @brief Упакованный массив битов.
+     */
+    class packed_bits {
+    public:
+        // лишнее нулевое слово в конце, чтобы читать 64 бита с любой позиции
+        explicit packed_bits(size_t size = 0) : words_(size / 64 + 2, 0) {}
+
+        bool get(size_t position) const {
+            return (words_[position / 64] >> (position % 64)) & 1;
+        }
+
+        void flip(size_t position) {
+            words_[position / 64] ^= static_cast<uint64_t>(1) << (position % 64);
+        }
+
+        /**
+         * @brief Количество позиций j = 0...length-1, в которых lhs[lhs_begin + j] и rhs[rhs_begin + j] - единицы.
+         */
+        static size_t and_count(const packed_bits &lhs, size_t lhs_begin, const packed_bits &rhs, size_t rhs_begin,
+                                size_t length) {
+            size_t result = 0;
+            for (size_t offset = 0; offset < length; offset += 64) {
+                auto word = lhs.word_at(lhs_begin + offset) & rhs.word_at(rhs_begin + offset);
+                if (length - offset < 64) {
+                    word &= (static_cast<uint64_t>(1) << (length - offset)) - 1;
+                }
+                result += __builtin_popcountll(word);
+            }
+            return result;
+        }
+
+    private:
+        /**
+         * @brief 64 бита, начиная с позиции position.
+         */
+        uint64_t word_at(size_t position) const {
+            const size_t index = position / 64, shift = position % 64;
+            if (shift == 0) {
+                return words_[index];
+            }
+            return (words_[index] >> shift) | (words_[index + 1] << (64 - shift));
+        }
+
+        std::vector<uint64_t> words_;
     };
-    return table[input];
-}
 
-/**
- * @brief Функция, непосредственно решающая задачу. Ищет симметричные тройки единиц во входных данных.
- * @param bits Входные данные (массив true(1) и false(0)).
- * @return Количество интересующих симметричных троек единиц.
- */
-size_t count_symmetrical_triples(const std::vector<bool> &bits) {
+    /**
+     * @brief Количество чётных (parity = 0) или нечётных (parity = 1) позиций.
+     */
+    size_t parity_size(size_t parity) const {
+        return (size_ + 1 - parity) / 2;
+    }
+
+    /**
+     * @brief Количество троек с центром в позиции, не считая сам центр.
+     */
+    size_t count_centered(size_t position) const;
+
+    /**
+     * @brief Количество троек, у которых позиция - крайняя, не считая саму позицию.
+     */
+    size_t count_outer(size_t position) const;
+
+    size_t size_;
+    size_t count_{0};
+    packed_bits direct_;  // direct_[i] = bits[i]
+    packed_bits reversed_;  // reversed_[i] = bits[n - 1 - i]
+    std::array<packed_bits, 2> decimated_;  // decimated_[p][i] = bits[2 * i + p]
+    std::array<packed_bits, 2> reversed_decimated_;  // отдельно чётные и нечётные позиции в обратном порядке
+};
+
+triples_counter::triples_counter(const std::vector<bool> &bits)
+        : size_(bits.size()), direct_(size_), reversed_(size_),
+          decimated_{packed_bits(parity_size(0)), packed_bits(parity_size(1))},
+          reversed_decimated_{packed_bits(parity_size(0)), packed_bits(parity_size(1))} {
+    for (size_t i = 0; i < size_; ++i) {
+        if (bits[i]) {
+            direct_.flip(i);
+            reversed_.flip(size_ - 1 - i);
+            decimated_[i % 2].flip(i / 2);
+            reversed_decimated_[i % 2].flip(parity_size(i % 2) - 1 - i / 2);
+        }
+    }
+    if (size_ < 3) {
+        return;
+    }
+    if (size_ < ntt_threshold) {
+        for (size_t i = 0; i < size_; ++i) {
+            if (bits[i]) {
+                count_ += count_centered(i);
+            }
+        }
+        return;
+    }
     /*
      * Произведём свёртку сигнала с самим собой.
      * В тех местах, где сигнал симметричен, мы получим большие значения свёртки.
      * Если значение свёртки >= 3, а в центре рассматриваемого кусочка сигнала стоит '1',
      * значит найдены симметричные тройки в этом кусочке сигнала.
      */
-    if (bits.size() < 3) {
-        return 0;
-    }
     auto autoconv = fft::convolution<bool, int64_t>(bits, bits);
-    size_t count = 0;
     for (size_t i = 2; i < autoconv.size() - 2; i += 2) {
         if (bits[i / 2]) {
-            count += (autoconv[i] - 1) / 2;
+            count_ += (autoconv[i] - 1) / 2;
         }
     }
-    return count;
+}
+
+size_t triples_counter::count_centered(size_t position) const {
+    // bits[position + d] и bits[position - d] = reversed_[n - 1 - position + d], d = 1...
+    const size_t length = std::min(position, size_ - 1 - position);
+    return packed_bits::and_count(direct_, position + 1, reversed_, size_ - position, length);
+}
+
+size_t triples_counter::count_outer(size_t position) const {
+    const size_t parity = position % 2, half = position / 2;
+    // Тройки position, position + d, position + 2d: bits[position + 2d] = decimated_[parity][half + d]
+    const size_t right = packed_bits::and_count(direct_, position + 1, decimated_[parity], half + 1,
+                                                (size_ - 1 - position) / 2);
+    // Тройки position - 2d, position - d, position: в обратном порядке позиции тоже идут подряд
+    const size_t left = packed_bits::and_count(reversed_, size_ - position, reversed_decimated_[parity],
+                                               parity_size(parity) - half, half);
+    return right + left;
+}
+
+void triples_counter::flip(size_t position) {
+    assert(position < size_);
+    // Позиция входит в каждую тройку не больше одного раза, а остальные биты троек не меняются
+    const size_t delta = count_centered(position) + count_outer(position);
+    if (get(position)) {
+        count_ -= delta;
+    } else {
+        count_ += delta;
+    }
+    direct_.flip(position);
+    reversed_.flip(size_ - 1 - position);
+    decimated_[position % 2].flip(position / 2);
+    reversed_decimated_[position % 2].flip(parity_size(position % 2) - 1 - position / 2);
+}
+
+/**
+ * @brief Функция, непосредственно решающая задачу. Ищет симметричные тройки единиц во входных данных.
+ * @param bits Входные данные (массив true(1) и false(0)).
+ * @return Количество интересующих симметричных троек единиц.
+ */
+size_t count_symmetrical_triples(const std::vector<bool> &bits) {
+    return triples_counter(bits).count();
 }
 
 // Начало тестов
@@ -375,10 +1070,88 @@ void test_random() {
     }
 }
 
+/**
+ * @brief Подсчёт симметричных троек перебором.
+ */
+size_t count_triples_naive(const std::vector<bool> &bits) {
+    size_t count = 0;
+    for (size_t center = 0; center < bits.size(); ++center) {
+        for (size_t d = 1; d <= center && center + d < bits.size(); ++d) {
+            count += bits[center] && bits[center - d] && bits[center + d];
+        }
+    }
+    return count;
+}
+
+void test_triples_counter() {
+    std::mt19937 gen(42);
+    // короткие последовательности считаются попарным сравнением, длинные - через NTT
+    for (size_t length: std::initializer_list<size_t>{1, 2, 3, 5, 63, 64, 65, 130, 300,
+                                                       triples_counter::ntt_threshold + 7}) {
+        std::vector<bool> bits(length);
+        for (size_t i = 0; i < length; ++i) {
+            bits[i] = gen() % 2;
+        }
+        triples_counter counter(bits);
+        assert(counter.count() == count_triples_naive(bits));
+        // после изменения отдельных битов количество пересчитывается, а не считается заново
+        for (auto i = 0; i < 20; ++i) {
+            const auto position = gen() % length;
+            bits[position] = !bits[position];
+            if (i % 2 == 0) {
+                counter.flip(position);
+            } else {
+                counter.set(position, bits[position]);
+            }
+            assert(counter.get(position) == bits[position]);
+            assert(counter.count() == count_triples_naive(bits));
+        }
+    }
+}
+
+void test_ntt_convolution() {
+    std::mt19937 gen(42);
+    // небольшие коэффициенты сворачиваются по одному модулю, большие - по трём;
+    // max_value^2 * 300 должно помещаться в int64_t, иначе эталонная свёртка переполнится
+    for (int64_t max_value: {1, 100, 1000000, 100000000}) {
+        std::uniform_int_distribution<int64_t> values_generator(-max_value, max_value);
+        std::uniform_int_distribution<size_t> length_generator(1, 300);
+        for (auto i = 0; i < 20; ++i) {
+            std::vector<int64_t> lhs(length_generator(gen)), rhs(length_generator(gen));
+            std::generate(lhs.begin(), lhs.end(), [&]() { return values_generator(gen); });
+            std::generate(rhs.begin(), rhs.end(), [&]() { return values_generator(gen); });
+            std::vector<int64_t> expected(lhs.size() + rhs.size() - 1);
+            for (size_t j = 0; j < lhs.size(); ++j) {
+                for (size_t k = 0; k < rhs.size(); ++k) {
+                    expected[j + k] += lhs[j] * rhs[k];
+                }
+            }
+            assert((fft::convolution<int64_t, int64_t>(lhs, rhs) == expected));
+        }
+    }
+}
+
+void test_real_convolution() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> values_generator(-1000, 1000);
+    std::uniform_int_distribution<size_t> length_generator(1, 300);
+    for (auto i = 0; i < 20; ++i) {
+        std::vector<int64_t> lhs(length_generator(gen)), rhs(length_generator(gen));
+        std::generate(lhs.begin(), lhs.end(), [&]() { return values_generator(gen); });
+        std::generate(rhs.begin(), rhs.end(), [&]() { return values_generator(gen); });
+        // вещественные сигналы сворачиваются через БПФ, целочисленные - через NTT
+        auto conv = fft::convolution<double, int64_t>({lhs.begin(), lhs.end()}, {rhs.begin(), rhs.end()});
+        assert((conv == fft::convolution<int64_t, int64_t>(lhs, rhs)));
+    }
+}
+
 void run_all_tests() {
+    test_ntt_convolution();
+    test_real_convolution();
     test_from_task();
     test_simple();
     test_random();
+    test_triples_counter();
 }
 
 // Конец тестов
@@ -75,7 +75,245 @@
 #include <numeric>
 #include <cctype>
 #include <utility>
-#include <queue>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <cstdint>
+#include <string_view>
+#include <sstream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+
+/**
+ * @brief Теоретико-числовое преобразование (NTT). Просто namespace с private-методами.
+ * @details Аналог преобразования Фурье в кольце вычетов по простому модулю вида c * 2^k + 1:
+ * вместо комплексных корней из единицы используются первообразные корни по модулю.
+ * Все вычисления целочисленные, поэтому свёртка получается точной, а не округлённой.
+ * Подробнее: https://cp-algorithms.com/algebra/fft.html#number-theoretic-transform
+ */
+class ntt {
+public:
+    /**
+     * @brief Выполнить теоретико-числовое преобразование на месте.
+     * @tparam Modulus Простой модуль вида c * 2^k + 1.
+     * @tparam Root Первообразный корень по модулю Modulus.
+     * @param values Вычеты. Длина - степень двойки, не больше 2^k.
+     * @param inverse True, если обратное преобразование, false - прямое.
+     */
+    template<uint32_t Modulus, uint32_t Root>
+    static void transform(std::vector<uint32_t> &values, bool inverse = false);
+
+    /**
+     * @brief Произвести точную свёртку двух целочисленных сигналов.
+     * @details Если коэффициенты свёртки заведомо меньше половины модуля, достаточно одного преобразования.
+     * Иначе свёртка вычисляется по трём модулям и восстанавливается по китайской теореме об остатках,
+     * что даёт точный результат для любых коэффициентов, помещающихся в 64 бита.
+     * @tparam InputType Целочисленный тип данных отсчётов входных сигналов.
+     * @tparam OutputIntegerType Целочисленный тип данных отсчётов свёртки.
+     * @param lhs Первая последовательность.
+     * @param rhs Вторая последовательность.
+     * @return Результат свёртки.
+     */
+    template<typename InputType, typename OutputIntegerType>
+    static std::vector<OutputIntegerType>
+    convolution(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs);
+
+private:
+    ntt() = default;  // запретим создание экзампляров класса
+
+    // модули вида c * 2^k + 1, для всех первообразный корень равен 3
+    static constexpr uint32_t modulus1 = 998244353;  // 119 * 2^23 + 1
+    static constexpr uint32_t modulus2 = 167772161;  // 5 * 2^25 + 1
+    static constexpr uint32_t modulus3 = 469762049;  // 7 * 2^26 + 1
+    static constexpr size_t max_length = static_cast<size_t>(1) << 23;  // ограничение первого модуля
+
+    /**
+     * @brief Возведение в степень по модулю.
+     * @param base Основание.
+     * @param exponent Показатель степени.
+     * @param modulus Модуль.
+     * @return base^exponent mod modulus.
+     */
+    static uint32_t power(uint32_t base, uint64_t exponent, uint32_t modulus);
+
+    /**
+     * @brief Свёртка по одному модулю.
+     * @tparam Modulus Простой модуль вида c * 2^k + 1.
+     * @tparam Root Первообразный корень по модулю Modulus.
+     * @param lhs Первая последовательность.
+     * @param rhs Вторая последовательность.
+     * @param size Длина преобразования, степень двойки.
+     * @return Вычеты коэффициентов свёртки, дополненные нулями до длины size.
+     */
+    template<uint32_t Modulus, uint32_t Root, typename InputType>
+    static std::vector<uint32_t>
+    convolution_modulo(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs, size_t size);
+
+    /**
+     * @brief Привести отсчёты сигнала по модулю.
+     * @tparam Modulus Модуль.
+     * @param values Отсчёты сигнала.
+     * @param size Длина результата, недостающие вычеты равны нулю.
+     * @return Неотрицательные вычеты отсчётов.
+     */
+    template<uint32_t Modulus, typename InputType>
+    static std::vector<uint32_t> reduce(const std::vector<InputType> &values, size_t size);
+};
+
+uint32_t ntt::power(uint32_t base, uint64_t exponent, uint32_t modulus) {
+    uint64_t result = 1;
+    uint64_t current = base % modulus;
+    for (; exponent > 0; exponent >>= 1) {
+        if (exponent & 1) {
+            result = result * current % modulus;
+        }
+        current = current * current % modulus;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+template<uint32_t Modulus, uint32_t Root>
+void ntt::transform(std::vector<uint32_t> &values, bool inverse) {
+    const auto n = values.size();
+    assert((n & (n - 1)) == 0 && (Modulus - 1) % n == 0);
+
+    // Поразрядно-обратная перестановка: j пробегает номера i, записанные в обратном порядке бит.
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(values[i], values[j]);
+        }
+    }
+
+    /*
+     * Стадии бабочки те же, что и в БПФ, только корень степени len из единицы - это Root^((Modulus - 1) / len).
+     * Степени корня вычисляются точно, поэтому накопление ошибки, как у комплексных чисел, здесь не грозит.
+     */
+    std::vector<uint32_t> roots(std::max<size_t>(n / 2, 1));
+    for (size_t len = 2; len <= n; len <<= 1) {
+        auto w_len = power(Root, (Modulus - 1) / len, Modulus);
+        if (inverse) {
+            w_len = power(w_len, Modulus - 2, Modulus);
+        }
+        roots[0] = 1;
+        for (size_t j = 1; j < len / 2; ++j) {
+            roots[j] = static_cast<uint64_t>(roots[j - 1]) * w_len % Modulus;
+        }
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < len / 2; ++j) {
+                uint32_t u = values[i + j];
+                auto v = static_cast<uint32_t>(static_cast<uint64_t>(values[i + j + len / 2]) * roots[j] % Modulus);
+                values[i + j] = u + v < Modulus ? u + v : u + v - Modulus;
+                values[i + j + len / 2] = u >= v ? u - v : u + Modulus - v;
+            }
+        }
+    }
+
+    // При обратном преобразовании каждый элемент делится на n, то есть умножается на обратный к n вычет.
+    if (inverse) {
+        const uint64_t n_inverse = power(static_cast<uint32_t>(n % Modulus), Modulus - 2, Modulus);
+        for (auto &value: values) {
+            value = static_cast<uint32_t>(value * n_inverse % Modulus);
+        }
+    }
+}
+
+template<uint32_t Modulus, typename InputType>
+std::vector<uint32_t> ntt::reduce(const std::vector<InputType> &values, size_t size) {
+    std::vector<uint32_t> result(size);
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto value = static_cast<int64_t>(values[i]) % static_cast<int64_t>(Modulus);
+        result[i] = static_cast<uint32_t>(value < 0 ? value + Modulus : value);
+    }
+    return result;
+}
+
+template<uint32_t Modulus, uint32_t Root, typename InputType>
+std::vector<uint32_t>
+ntt::convolution_modulo(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs, size_t size) {
+    auto values1 = reduce<Modulus>(lhs, size);
+    transform<Modulus, Root>(values1);
+    if (&lhs == &rhs) {
+        // свёртка последовательности с самой собой: достаточно одного прямого преобразования
+        for (size_t i = 0; i < size; ++i) {
+            values1[i] = static_cast<uint32_t>(static_cast<uint64_t>(values1[i]) * values1[i] % Modulus);
+        }
+    } else {
+        auto values2 = reduce<Modulus>(rhs, size);
+        transform<Modulus, Root>(values2);
+        for (size_t i = 0; i < size; ++i) {
+            values1[i] = static_cast<uint32_t>(static_cast<uint64_t>(values1[i]) * values2[i] % Modulus);
+        }
+    }
+    transform<Modulus, Root>(values1, true);
+    return values1;
+}
+
+template<typename InputType, typename OutputIntegerType>
+std::vector<OutputIntegerType> ntt::convolution(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs) {
+    if (lhs.empty() || rhs.empty()) {
+        return {};
+    }
+    const size_t conv_length = lhs.size() + rhs.size() - 1;
+    size_t size = 1;
+    while (size < conv_length) {
+        size <<= 1;
+    }
+    assert(size <= max_length);
+
+    // Оценка сверху для модуля коэффициентов свёртки.
+    auto max_abs = [](const std::vector<InputType> &values) {
+        double result = 0;
+        for (const auto &value: values) {
+            result = std::max(result, std::abs(static_cast<double>(value)));
+        }
+        return result;
+    };
+    const double bound = max_abs(lhs) * max_abs(rhs) * static_cast<double>(std::min(lhs.size(), rhs.size()));
+
+    std::vector<OutputIntegerType> result(conv_length);
+    if (bound < modulus1 / 2) {
+        // Вычеты больше половины модуля соответствуют отрицательным коэффициентам.
+        auto residues = convolution_modulo<modulus1, 3>(lhs, rhs, size);
+        for (size_t i = 0; i < conv_length; ++i) {
+            auto value = static_cast<int64_t>(residues[i]);
+            result[i] = static_cast<OutputIntegerType>(value > modulus1 / 2 ? value - modulus1 : value);
+        }
+        return result;
+    }
+
+    /*
+     * Алгоритм Гарнера: коэффициент x = x1 + x2 * m1 + x3 * m1 * m2, где 0 <= xi < mi.
+     * Цифры xi последовательно находятся из остатков r1, r2, r3 по модулям m1, m2, m3.
+     * Произведение модулей больше 2^78, поэтому любой 64-битный коэффициент восстанавливается однозначно.
+     */
+    auto residues1 = convolution_modulo<modulus1, 3>(lhs, rhs, size);
+    auto residues2 = convolution_modulo<modulus2, 3>(lhs, rhs, size);
+    auto residues3 = convolution_modulo<modulus3, 3>(lhs, rhs, size);
+    const uint64_t m1 = modulus1, m2 = modulus2, m3 = modulus3;
+    const uint64_t m1_inverse = power(modulus1 % modulus2, m2 - 2, modulus2);  // m1^-1 mod m2
+    const uint64_t m12_inverse = power(m1 * m2 % m3, m3 - 2, modulus3);  // (m1 * m2)^-1 mod m3
+    const auto m123 = static_cast<__int128>(m1 * m2) * m3;
+    for (size_t i = 0; i < conv_length; ++i) {
+        const uint64_t x1 = residues1[i];
+        const uint64_t x2 = (residues2[i] + m2 - x1 % m2) * m1_inverse % m2;
+        const uint64_t x3 = (residues3[i] + m3 - (x1 + x2 * m1) % m3) * m12_inverse % m3;
+        auto value = static_cast<__int128>(x1 + x2 * m1) + static_cast<__int128>(x3) * (m1 * m2);
+        if (value > m123 / 2) {
+            value -= m123;
+        }
+        result[i] = static_cast<OutputIntegerType>(value);
+    }
+    return result;
+}
 
 
 /**
@@ -84,102 +322,292 @@
 class fft {
 public:
     /**
-     * @brief Выполнить преобразование Фурье.
-     * @details Нерекурсивная реализация.
-     * @param samples Отсчёты сигнала, от которого берём прямое преобразование, или спектр для обратного преобразования.
-     * @param inverse True, если обратное преобразование, false - прямое.
-     * @return Спектр сигнала при прямом преобразовании, отсчёты сигнала - при обратном.
+     * @brief Реализации стадий бабочки.
+     * @details Векторные реализации обрабатывают за одну инструкцию 2 (SSE2) или 4 (AVX2) бабочки.
+     * Все реализации выполняют одни и те же операции в одном и том же порядке, поэтому дают одинаковый до бита результат.
      */
-    static std::vector<std::complex<double>>
-    transfrom(std::vector<std::complex<double>> samples, bool inverse = false) {
-        pad(samples);
-        /*
-         * Вначале к вектору a применяется поразрядно обратная перестановка, для чего вычисляется количество
-         * значащих бит (lg n) в числе n, и для каждой позиции i находится соответствующая ей позиция,
-         * битовая запись которой есть битовая запись числа i, записанная в обратном порядке.
-         * Если получившаяся в результате позиция оказалась больше i, то элементы в этих двух позициях надо обменять
-         * (если не это условие, то каждая пара обменяется дважды, и в итоге ничего не произойдёт).
+    enum class kernel {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    /**
+     * @brief Поддерживает ли процессор реализацию.
+     * @param type Реализация.
+     * @return True, если реализацию можно использовать.
+     */
+    static bool is_supported(kernel type);
+
+    /**
+     * @brief Самая быстрая реализация, которую поддерживает процессор. Определяется один раз при первом вызове.
+     */
+    static kernel best_kernel();
+
+    /**
+     * @brief План преобразования Фурье фиксированной длины.
+     * @details Хранит поразрядно-обратную перестановку и поворачивающие множители (twiddle factors),
+     * поэтому повторные преобразования одной длины не вычисляют их заново, не сортируют и не выделяют память.
+     */
+    class plan {
+    public:
+        /**
+         * @brief Построить план.
+         * @param size Длина преобразования. Должна быть степенью двойки.
+         */
+        explicit plan(size_t size);
+
+        /**
+         * @brief Длина преобразования.
+         */
+        size_t size() const {
+            return reversed_.size();
+        }
+
+        /**
+         * @brief Выполнить преобразование Фурье на месте.
+         * @details Нерекурсивная реализация. На время преобразования отсчёты раскладываются в два массива:
+         * действительные и мнимые части (SoA), чтобы стадии бабочки можно было векторизовать.
+         * @param samples Отсчёты сигнала для прямого преобразования или спектр для обратного. Длина должна совпадать с длиной плана.
+         * @param inverse True, если обратное преобразование, false - прямое.
+         * @param type Реализация стадий бабочки. Должна поддерживаться процессором.
          */
-        samples = sort_by_reverse_index(samples);
+        void transform(std::vector<std::complex<double>> &samples, bool inverse = false,
+                       kernel type = best_kernel()) const;
 
+    private:
+        std::vector<uint32_t> reversed_;  // reversed_[i] - число i с обратным порядком log(n) младших бит
         /*
-         * Мы применили поразрядно обратную перестановку элементов.
-         * Теперь выполним всю работу, выполняемую нижним уровнем рекурсии, т.е. вектор отсчётов разделим на пары
-         * элементов, для каждого применим преобразование бабочки, в результате в векторе отсчётов будут находиться
-         * результаты работы нижнего уровня рекурсии. На следующем шаге разделим вектор a на четвёрки элементов,
-         * к каждой применим преобразование бабочки, в результате получим ДПФ для каждой четвёрки.
-         * И так далее, наконец, на последнем шаге мы, получив результаты ДПФ для двух половинок вектора отсчётов,
-         * применим к ним преобразование бабочки и получим ДПФ для всего вектора отсчётов.
+         * Поворачивающие множители всех стадий подряд: для блоков длины len множители w^j = exp(2*pi*i*j/len),
+         * j = 0...len/2-1, лежат начиная с позиции len/2. Каждый множитель вычислен отдельно через cos и sin,
+         * а не накоплен умножением, поэтому ошибка округления не растёт вдоль блока.
+         * Действительные и мнимые части хранятся в отдельных массивах.
          */
+        std::vector<double> roots_re_;
+        std::vector<double> roots_im_;
+    };
 
+    /**
+     * @brief План преобразования Фурье вещественного сигнала.
+     * @details Вещественный сигнал длины n упаковывается в комплексный сигнал длины n/2: чётные отсчёты становятся
+     * действительной частью, нечётные - мнимой. Он преобразуется планом половинной длины, после чего спектры
+     * чётных и нечётных отсчётов разделяются и объединяются последней стадией бабочки.
+     * Спектр вещественного сигнала симметричен (X[n-k] = X[k]*), поэтому хранятся только отсчёты 0...n/2.
+     * Так преобразование требует вдвое меньше вычислений и памяти, чем комплексное той же длины.
+     */
+    class real_plan {
+    public:
+        /**
+         * @brief Построить план.
+         * @param size Длина вещественного сигнала. Должна быть степенью двойки, не меньше 2.
+         */
+        explicit real_plan(size_t size);
+
+        /**
+         * @brief Длина вещественного сигнала.
+         */
+        size_t size() const {
+            return 2 * half_.size();
+        }
 
-        for (size_t len = 2; len <= samples.size(); len <<= 1) {
-            /*
-             * Выполняется (log(n) - 1) стадий алгоритма, на k-ой из которых (k=2...log(n)) вычисляются ДПФ для блоков
-             * длины 2^k. Для всех этих блоков будет одно и то же значение первообразного корня, которое запоминается
-             * в переменной w_current.
-             * Цикл по i итерируется по блокам,
-             * а вложенный в него цикл по j применяет преобразование бабочки ко всем элементам блока.
-             */
-            double arg = 2 * M_PI / len * (inverse ? -1 : 1);
-            std::complex<double> w_current(cos(arg), sin(arg));
-            for (int i = 0; i < samples.size(); i += len) {
-                std::complex<double> w(1);
-                for (int j = 0; j < len / 2; ++j) {
-                    std::complex<double> u = samples[i + j], v = samples[i + j + len / 2] * w;
-                    samples[i + j] = u + v;
-                    samples[i + j + len / 2] = u - v;
-                    w *= w_current;
+        /**
+         * @brief Прямое преобразование вещественного сигнала.
+         * @tparam SampleType Тип данных отсчётов сигнала.
+         * @param samples Отсчёты сигнала. Если их меньше длины плана, сигнал дополняется нулями.
+         * @param spectrum Сюда записываются n/2 + 1 первых отсчётов спектра.
+         */
+        template<typename SampleType>
+        void transform(const std::vector<SampleType> &samples, std::vector<std::complex<double>> &spectrum) const {
+            assert(samples.size() <= size());
+            spectrum.reserve(half_.size() + 1);
+            spectrum.assign(half_.size(), 0);
+            for (size_t i = 0; i < samples.size(); ++i) {
+                if (i % 2 == 0) {
+                    spectrum[i / 2].real(static_cast<double>(samples[i]));
+                } else {
+                    spectrum[i / 2].imag(static_cast<double>(samples[i]));
                 }
             }
+            split_spectrum(spectrum);
         }
-        /*
-         * Если указан флаг inverse = true, то w_n заменяется на w_n^-1, а каждый элемент результата делится на 2
-         * (учитывая, что эти деления на 2 произойдут в каждом уровне рекурсии, то в итоге как раз получится,
-         * что все элементы поделятся на n).
+
+        /**
+         * @brief Обратное преобразование спектра вещественного сигнала.
+         * @param spectrum n/2 + 1 первых отсчётов спектра. Используется как рабочий буфер, содержимое портится.
+         * @param samples Сюда записываются n отсчётов сигнала.
          */
-        if (inverse) {
-            std::for_each(samples.begin(), samples.end(), [&samples](auto &sample) { sample /= samples.size(); });
-        }
+        void inverse_transform(std::vector<std::complex<double>> &spectrum, std::vector<double> &samples) const;
 
-        return samples;
-    }
+    private:
+        /**
+         * @brief Получить спектр вещественного сигнала из спектра упакованного сигнала.
+         * @param spectrum Упакованный сигнал в первых n/2 отсчётах. Заменяется на n/2 + 1 отсчётов спектра.
+         */
+        void split_spectrum(std::vector<std::complex<double>> &spectrum) const;
+
+        const plan &half_;
+        std::vector<std::complex<double>> twiddles_;  // twiddles_[k] = exp(2*pi*i*k/n), k = 0...n/2-1
+    };
 
     /**
-     * @brief Преобразование Фурье для двух вещественных сигналов.
-     * @details Вещественные сигналы объединяются и производится комплексное преобразование.
-     * @param x Первый сигнал.
-     * @param y Второй сигнал.
-     * @return Кортеж из двух спектров.
+     * @brief Многоканальная корреляция с неизменным текстом.
+     * @details Для K каналов вычисляет сумму корреляционных функций текста и образца:
+     * r[i] = sum(text_c[i + j] * pattern_c[j]), сумма по каналам c и позициям образца j, i = 0...|text|-|pattern|.
+     * Каналы объединяются парами в комплексные сигналы x + iy, поэтому K каналов требуют K/2 прямых преобразований.
+     * Спектры текста вычисляются один раз и переиспользуются для всех образцов.
      */
-    static std::tuple<std::vector<std::complex<double>>, std::vector<std::complex<double>>>
-    double_transfrom(std::vector<double> x, std::vector<double> y) {
-        using namespace std::complex_literals;
+    class correlator {
+    public:
+        /**
+         * @brief Вычислить спектры текста.
+         * @param text Каналы текста. Все каналы одной длины.
+         */
+        explicit correlator(const std::vector<std::vector<double>> &text);
 
-        x.resize(std::max(x.size(), y.size()));
-        y.resize(std::max(x.size(), y.size()));
+        /**
+         * @brief Количество каналов.
+         */
+        size_t channels() const {
+            return channels_;
+        }
+
+        /**
+         * @brief Корреляция текста с образцом.
+         * @param pattern Каналы образца: столько же, сколько у текста, все одной длины, не больше длины текста.
+         * @return Сумма корреляционных функций каналов для всех положений образца в тексте.
+         */
+        std::vector<double> correlate(const std::vector<std::vector<double>> &pattern) const;
+
+    private:
+        /**
+         * @brief Спектры пар каналов: каналы 2p и 2p+1 объединяются в комплексный сигнал.
+         * @details Сигналы дополняются нулями до длины плана.
+         */
+        std::vector<std::vector<std::complex<double>>> pair_spectrums(
+                const std::vector<std::vector<double>> &channels) const;
 
-        // z(n) = x(n) + iy(n)
-        // x(n) = (z(n) + z(n)∗)/2
-        // y(n) = −i(z(n) − z(n)∗)/2
-        std::vector<std::complex<double>> joined;
-        for (size_t i = 0; i < x.size(); ++i) {
-            joined.emplace_back(x[i], y[i]);
+        size_t channels_;
+        size_t text_length_;
+        const real_plan &real_plan_;  // для обратного преобразования: сумма корреляций - вещественный сигнал
+        const plan &plan_;
+        std::vector<std::vector<std::complex<double>>> text_spectrums_;
+    };
+
+    /**
+     * @brief Потоковый поиск подстроки в тексте неограниченной длины.
+     * @details Текст обрабатывается блоками фиксированной длины методом перекрытия с сохранением (overlap-save):
+     * каждый блок начинается с последних |pattern|-1 символов предыдущего, поэтому вхождения на стыке блоков
+     * не теряются, а циклическая корреляция блока с образцом верна для всех положений образца внутри блока.
+     * Спектр образца вычисляется один раз. Память ограничена длиной блока и не зависит от длины текста.
+     */
+    class substring_stream {
+    public:
+        /**
+         * @brief Подготовить поиск.
+         * @param pattern Подстрока, которую ищем. Не пустая.
+         * @param block_length Длина блока, 0 - выбрать автоматически.
+         * Округляется вверх до степени двойки, не меньшей длины подстроки.
+         */
+        explicit substring_stream(const std::string &pattern, size_t block_length = 0);
+
+        /**
+         * @brief Длина блока.
+         */
+        size_t block_length() const {
+            return plan_.size();
         }
-        auto fft_joined = transfrom(joined);
 
-        // FFT(x)[k] = (FFT(z)[k] + FFTN(z)[N − k]∗)/2
-        // FFT(x)[k] = -i(FFT(z)[k] - FFTN(z)[N − k]∗)/2
-        std::vector<std::complex<double>> fft_x, fft_y;
-        fft_x.push_back((fft_joined[0] + std::conj(fft_joined[0])) / 2.0);
-        fft_y.push_back(std::complex<double>(-1.0i) * (fft_joined[0] - std::conj(fft_joined[0])) / 2.0);
+        /**
+         * @brief Обработать очередной кусок текста.
+         * @tparam Callback Тип функции, вызываемой для каждого вхождения.
+         * @param chunk Кусок текста, продолжающий уже переданные.
+         * @param on_match Вызывается с позицией каждого вхождения, отсчитанной от начала всего текста.
+         * Позиции сообщаются по возрастанию, как только заполнится блок, в котором вхождение заканчивается.
+         */
+        template<typename Callback>
+        void feed(std::string_view chunk, Callback on_match) {
+            while (!chunk.empty()) {
+                const auto count = std::min(chunk.size(), block_length() - block_.size());
+                block_.append(chunk.substr(0, count));
+                chunk.remove_prefix(count);
+                if (block_.size() == block_length()) {
+                    for (auto position: process_block()) {
+                        on_match(position);
+                    }
+                }
+            }
+        }
 
-        size_t N = fft_joined.size();
-        for (size_t i = 1; i < fft_joined.size(); ++i) {
-            fft_x.push_back((fft_joined[i] + std::conj(fft_joined[N - i])) / 2.0);
-            fft_y.push_back(std::complex<double>(-1.0i) * (fft_joined[i] - std::conj(fft_joined[N - i])) / 2.0);
+        /**
+         * @brief Найти вхождения в уже переданной, но ещё не обработанной части текста (например, в конце текста).
+         * @details После этого можно продолжать передавать текст.
+         */
+        template<typename Callback>
+        void flush(Callback on_match) {
+            if (block_.size() >= pattern_length_) {
+                for (auto position: process_block()) {
+                    on_match(position);
+                }
+            }
         }
-        return {fft_x, fft_y};
+
+    private:
+        /**
+         * @brief Найти вхождения, целиком лежащие в текущем блоке, и оставить в блоке только перекрытие.
+         * @return Позиции вхождений от начала всего текста.
+         */
+        const std::vector<size_t> &process_block();
+
+        size_t pattern_length_;
+        int64_t pattern_squares_;  // сумма квадратов кодов символов образца
+        const real_plan &plan_;
+        std::vector<std::complex<double>> pattern_spectrum_;  // сопряжённый спектр образца
+        std::string block_;
+        size_t offset_{0};  // позиция начала блока в тексте
+        // рабочие буферы, переиспользуются между блоками
+        std::vector<double> samples_;
+        std::vector<std::complex<double>> spectrum_;
+        std::vector<int64_t> prefix_squares_;
+        std::vector<size_t> found_;
+    };
+
+    /**
+     * @brief Получить план преобразования заданной длины. Планы строятся один раз и переиспользуются.
+     * @details Можно вызывать из нескольких потоков: построенный план не изменяется.
+     * @param size Длина преобразования. Должна быть степенью двойки.
+     * @return План.
+     */
+    static const plan &get_plan(size_t size);
+
+    /**
+     * @brief Получить план преобразования вещественного сигнала. Планы строятся один раз и переиспользуются.
+     * @details Можно вызывать из нескольких потоков: построенный план не изменяется.
+     * @param length Длина сигнала. Округляется вверх до степени двойки, не меньшей 2.
+     * @return План.
+     */
+    static const real_plan &get_real_plan(size_t length);
+
+    /**
+     * @brief Выполнить преобразование Фурье на месте.
+     * @details Последовательность дополняется нулями до длины, равной степени двойки.
+     * @param samples Отсчёты сигнала, от которого берём прямое преобразование, или спектр для обратного преобразования.
+     * @param inverse True, если обратное преобразование, false - прямое.
+     */
+    static void transform_inplace(std::vector<std::complex<double>> &samples, bool inverse = false) {
+        pad(samples);
+        get_plan(samples.size()).transform(samples, inverse);
+    }
+
+    /**
+     * @brief Выполнить преобразование Фурье.
+     * @param samples Отсчёты сигнала, от которого берём прямое преобразование, или спектр для обратного преобразования.
+     * @param inverse True, если обратное преобразование, false - прямое.
+     * @return Спектр сигнала при прямом преобразовании, отсчёты сигнала - при обратном.
+     */
+    static std::vector<std::complex<double>>
+    transfrom(std::vector<std::complex<double>> samples, bool inverse = false) {
+        transform_inplace(samples, inverse);
+        return samples;
     }
 
     /**
@@ -193,33 +621,28 @@ public:
     template<typename InputType, typename OutputIntegerType>
     static std::vector<OutputIntegerType>
     convolution(const std::vector<InputType> &lhs, const std::vector<InputType> &rhs) {
-        std::vector<std::complex<double>> samples1(lhs.begin(), lhs.end()), samples2(rhs.begin(), rhs.end());
-
-        size_t conv_length = samples1.size() + samples2.size() - 1;
-
-        samples1.resize(conv_length);
-        samples2.resize(conv_length);
-
-        auto spectrum1 = fft::transfrom(samples1);
-        auto spectrum2 = fft::transfrom(samples2);
+        if constexpr (std::is_integral_v<InputType>) {
+            // целочисленные сигналы сворачиваем точно, без округления комплексных чисел
+            return ntt::convolution<InputType, OutputIntegerType>(lhs, rhs);
+        }
+        // вещественные сигналы сворачиваем преобразованием вещественного сигнала: оно вдвое дешевле комплексного
+        const size_t conv_length = lhs.size() + rhs.size() - 1;
+        const auto &plan = fft::get_real_plan(conv_length);
 
-        std::vector<std::complex<double>> production_spectrum;
-        production_spectrum.reserve(spectrum1.size());
-        std::transform(
-                spectrum1.begin(), spectrum1.end(),
-                spectrum2.begin(),
-                std::back_inserter(production_spectrum),
-                [](const auto &lhs, const auto &rhs) {
-                    return lhs * rhs;
-                });
-        auto production_samples = fft::transfrom(production_spectrum, true);
+        std::vector<std::complex<double>> spectrum1, spectrum2;
+        plan.transform(lhs, spectrum1);
+        plan.transform(rhs, spectrum2);
+        for (size_t i = 0; i < spectrum1.size(); ++i) {
+            spectrum1[i] *= spectrum2[i];
+        }
+        std::vector<double> production_samples;
+        plan.inverse_transform(spectrum1, production_samples);
 
         std::vector<OutputIntegerType> result;
-        result.reserve(production_samples.size());
-        for (const auto &sample: production_samples) {
-            result.emplace_back(std::llround(sample.real()));
+        result.reserve(conv_length);
+        for (size_t i = 0; i < conv_length; ++i) {
+            result.emplace_back(std::llround(production_samples[i]));
         }
-        result.resize(conv_length);
         return result;
     }
 
@@ -242,6 +665,52 @@ public:
         return result;
     }
 
+    /**
+     * @brief Потоковый поиск подстроки в тексте, читаемом из потока.
+     * @details Текст читается и обрабатывается блоками, поэтому его длина ограничена только потоком, а не памятью.
+     * @tparam Callback Тип функции, вызываемой для каждого вхождения.
+     * @param text Поток, из которого читается текст до конца.
+     * @param pattern Подстрока, которую ищем. Не пустая.
+     * @param on_match Вызывается с позицией каждого вхождения по возрастанию позиций.
+     * @param block_length Длина блока, 0 - выбрать автоматически.
+     */
+    template<typename Callback>
+    static void find_substring(std::istream &text, const std::string &pattern, Callback on_match,
+                               size_t block_length = 0) {
+        substring_stream stream(pattern, block_length);
+        std::string chunk(stream.block_length(), '\0');
+        while (text.read(chunk.data(), chunk.size()) || text.gcount() > 0) {
+            stream.feed(std::string_view(chunk.data(), text.gcount()), on_match);
+        }
+        stream.flush(on_match);
+    }
+
+    /**
+     * @brief Расстояние Хэмминга между образцом и текстом для всех положений образца.
+     * @details Символ образца p[j] в положении i совпадает, если в тексте на расстоянии не более k от позиции i + j
+     * есть такой же символ или джокер. Джокер в образце совпадает с чем угодно.
+     * При k = 0 и без джокеров это обычное расстояние Хэмминга.
+     * Каждому символу образца соответствует канал, каналы коррелируются попарно (см. correlator).
+     * @param text Строка, в которой ищем.
+     * @param pattern Строка, которую ищем.
+     * @param k Степень погрешности: на каком расстоянии в тексте искать символ образца.
+     * @param wildcard Джокер (don't care), совпадающий с любым символом, если задан.
+     * @return Количество несовпавших символов образца для положений 0...|text|-|pattern|.
+     */
+    static std::vector<size_t> mismatches(const std::string &text, const std::string &pattern, size_t k = 0,
+                                          std::optional<char> wildcard = std::nullopt);
+
+    /**
+     * @brief Поиск подстроки с джокерами в тексте и в образце.
+     * @details Стоимость не зависит от размера алфавита: три точные целочисленные свёртки.
+     * @param text Строка, в которой ищем.
+     * @param pattern Подстрока, которую ищем.
+     * @param wildcard Джокер, совпадающий с любым символом.
+     * @return Позиции всех вхождений подстроки в строку.
+     */
+    static std::vector<size_t> find_with_wildcards(const std::string &text, const std::string &pattern,
+                                                   char wildcard);
+
     /**
      * @brief Циклическая корреляционная функция.
      * @details Скалярные произведения для всех циклических сдвигов строк друг относительно друга.
@@ -342,267 +811,534 @@ private:
     static size_t round_pow2(size_t number);
 
     /**
-     * @brief Поразрядно-обратная перестановка элементов. Bit-reversal permutation.
-     * @details В позиции i каждого элемента a[i] инвертируем порядок битов, и переупорядочим элементы массива в соответствии с новыми индексами.
-     * @param samples Массив отсчётов сигнала или спектра.
-     * @return Результат поразрядно-обратной перестановки элементов.
+     * @brief Все стадии бабочки для отсчётов, уже переставленных в поразрядно-обратном порядке.
+     * @param re Действительные части отсчётов.
+     * @param im Мнимые части отсчётов.
+     * @param n Количество отсчётов, степень двойки.
+     * @param roots_re Действительные части поворачивающих множителей плана.
+     * @param roots_im Мнимые части поворачивающих множителей плана.
+     * @param sign 1 для прямого преобразования, -1 для обратного (множители заменяются сопряжёнными).
      */
-    static std::vector<std::complex<double>> sort_by_reverse_index(const std::vector<std::complex<double>> &samples);
+    static void butterflies_scalar(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                                   double sign);
+#if defined(__x86_64__) || defined(__i386__)
+    static void butterflies_sse2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                                 double sign);
+    static void butterflies_avx2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                                 double sign);
+#endif
 
     /**
-     * @brief Инвертировать порядок бит в числе.
-     * @tparam NumberType2 Тип данных числа.
-     * @param input Число.
-     * @return Число с обратным порядком бит.
+     * @brief Одна стадия бабочки без векторизации: для блоков длины len, начиная с позиции, кратной len.
+     * @details Используется скалярной реализацией и векторными для коротких блоков.
      */
-    template<typename NumberType2>
-    static NumberType2 reverse_bits(NumberType2 input);
+    static void stage_scalar(double *re, double *im, size_t n, size_t len, const double *roots_re,
+                             const double *roots_im, double sign) {
+        const size_t half = len / 2;
+        for (size_t i = 0; i + len <= n; i += len) {
+            for (size_t j = 0; j < half; ++j) {
+                const double w_re = roots_re[half + j], w_im = sign * roots_im[half + j];
+                const double v_re = re[i + j + half] * w_re - im[i + j + half] * w_im;
+                const double v_im = re[i + j + half] * w_im + im[i + j + half] * w_re;
+                re[i + j + half] = re[i + j] - v_re;
+                im[i + j + half] = im[i + j] - v_im;
+                re[i + j] = re[i + j] + v_re;
+                im[i + j] = im[i + j] + v_im;
+            }
+        }
+    }
+};
 
-    /**
-     * @brief Инвертировать порядок байт в числе.
-     * @tparam NumberType2 Тип данных числа.
-     * @param input Число.
-     * @return Число с обратным порядком байт.
+fft::plan::plan(size_t size)
+        : reversed_(size), roots_re_(std::max<size_t>(size, 2)), roots_im_(std::max<size_t>(size, 2)) {
+    /*
+     * Поразрядно-обратная перестановка за O(n): запись числа i в обратном порядке - это запись числа i / 2
+     * в обратном порядке, сдвинутая на один разряд, к которой слева дописан младший бит i.
      */
-    template<typename NumberType2>
-    static NumberType2 reverse_bytes(NumberType2 input);
+    size_t log_size = 0;
+    while ((static_cast<size_t>(1) << log_size) < size) {
+        ++log_size;
+    }
+    for (size_t i = 1; i < size; ++i) {
+        reversed_[i] = (reversed_[i >> 1] >> 1) | ((i & 1) << (log_size - 1));
+    }
 
-};
+    /*
+     * Множители последней стадии вычисляем напрямую, множители предыдущих стадий - это каждый второй,
+     * каждый четвёртый и т.д. множитель последней стадии.
+     */
+    const auto half = size / 2;
+    for (size_t j = 0; j < half; ++j) {
+        double arg = 2 * M_PI * j / size;
+        roots_re_[half + j] = cos(arg);
+        roots_im_[half + j] = sin(arg);
+    }
+    for (size_t len = half; len >= 2; len >>= 1) {
+        for (size_t j = 0; j < len / 2; ++j) {
+            roots_re_[len / 2 + j] = roots_re_[half + j * (size / len)];
+            roots_im_[len / 2 + j] = roots_im_[half + j * (size / len)];
+        }
+    }
+}
 
-std::vector<std::complex<double>> fft::sort_by_reverse_index(const std::vector<std::complex<double>> &samples) {
-    static std::vector<size_t> reverse_bits_permutation;
+void fft::plan::transform(std::vector<std::complex<double>> &samples, bool inverse, kernel type) const {
+    assert(samples.size() == size());
+    assert(is_supported(type));
+    /*
+     * Вначале к вектору a применяется поразрядно обратная перестановка:
+     * на позицию i попадает элемент с позиции, битовая запись которой есть битовая запись числа i в обратном порядке.
+     * Одновременно раскладываем отсчёты на действительные и мнимые части.
+     * Буферы свои у каждого потока и переиспользуются между вызовами.
+     */
+    thread_local std::vector<double> re, im;
+    re.resize(samples.size());
+    im.resize(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        re[i] = samples[reversed_[i]].real();
+        im[i] = samples[reversed_[i]].imag();
+    }
 
-    // Найдём нужную перестановку.
-    if (reverse_bits_permutation.size() != samples.size()) {
-        reverse_bits_permutation.resize(samples.size());
-        size_t i = 0;
-        std::iota(reverse_bits_permutation.begin(), reverse_bits_permutation.end(), i++);
-        sort(reverse_bits_permutation.begin(), reverse_bits_permutation.end(),
-             [&](size_t i, size_t j) { return reverse_bits(i) < reverse_bits(j); });
+    /*
+     * Мы применили поразрядно обратную перестановку элементов.
+     * Теперь выполним всю работу, выполняемую нижним уровнем рекурсии, т.е. вектор отсчётов разделим на пары
+     * элементов, для каждого применим преобразование бабочки, в результате в векторе отсчётов будут находиться
+     * результаты работы нижнего уровня рекурсии. На следующем шаге разделим вектор a на четвёрки элементов,
+     * к каждой применим преобразование бабочки, в результате получим ДПФ для каждой четвёрки.
+     * И так далее, наконец, на последнем шаге мы, получив результаты ДПФ для двух половинок вектора отсчётов,
+     * применим к ним преобразование бабочки и получим ДПФ для всего вектора отсчётов.
+     * Для обратного преобразования w_n заменяется на w_n^-1, то есть на сопряжённое число.
+     */
+    const double sign = inverse ? -1.0 : 1.0;
+    switch (type) {
+#if defined(__x86_64__) || defined(__i386__)
+        case kernel::avx2:
+            butterflies_avx2(re.data(), im.data(), samples.size(), roots_re_.data(), roots_im_.data(), sign);
+            break;
+        case kernel::sse2:
+            butterflies_sse2(re.data(), im.data(), samples.size(), roots_re_.data(), roots_im_.data(), sign);
+            break;
+#endif
+        default:
+            butterflies_scalar(re.data(), im.data(), samples.size(), roots_re_.data(), roots_im_.data(), sign);
+            break;
     }
 
-    // Пересортируем элементы
-    std::vector<std::complex<double>> result;
-    result.reserve(samples.size());
-    for (auto idx: reverse_bits_permutation) {
-        result.push_back(samples[idx]);
+    /*
+     * При обратном преобразовании каждый элемент результата делится на n.
+     */
+    const double scale = inverse ? 1.0 / samples.size() : 1.0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = std::complex<double>(re[i] * scale, im[i] * scale);
     }
+}
 
-    return result;
+bool fft::is_supported(kernel type) {
+    switch (type) {
+        case kernel::scalar:
+            return true;
+#if defined(__x86_64__) || defined(__i386__)
+        case kernel::sse2:
+            return __builtin_cpu_supports("sse2");
+        case kernel::avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
 }
 
-size_t fft::round_pow2(size_t number) {
-    double x = static_cast<double>(number -
-                                   1);  // если убрать "- 1", то "не меньше" в описании нужно заменить на "больше"
-    auto answer = reinterpret_cast<unsigned int *>(&x);
-    ++answer;
-    return static_cast<size_t>(1) << (((*answer & 0x7FF00000) >> 20) - 1022);
+fft::kernel fft::best_kernel() {
+    static const kernel best = is_supported(kernel::avx2) ? kernel::avx2 :
+                               is_supported(kernel::sse2) ? kernel::sse2 : kernel::scalar;
+    return best;
 }
 
-void fft::pad(std::vector<std::complex<double>> &samples) {
-    size_t new_size = round_pow2(samples.size());
-    samples.resize(new_size);
+void fft::butterflies_scalar(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                             double sign) {
+    for (size_t len = 2; len <= n; len <<= 1) {
+        stage_scalar(re, im, n, len, roots_re, roots_im, sign);
+    }
 }
 
-template<typename NumberType2>
-NumberType2 fft::reverse_bits(NumberType2 input) {
-    auto result = reverse_bytes(input);
-    for (size_t i = 0; i < sizeof(NumberType2); ++i) {
-        *(reinterpret_cast<uint8_t *>(&result) + i) = reverse_bits(*(reinterpret_cast<uint8_t *>(&result) + i));
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+ * Векторные реализации обрабатывают бабочки j, j+1, ... блока одновременно: в массивах SoA соседние
+ * действительные (и мнимые) части лежат подряд, поэтому загружаются одной инструкцией.
+ * Блоки короче ширины вектора обрабатываются скалярно. FMA не используется, чтобы результат совпадал со скалярным.
+ */
+__attribute__((target("sse2")))
+void fft::butterflies_sse2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                           double sign) {
+    stage_scalar(re, im, n, 2, roots_re, roots_im, sign);
+    const __m128d sign_vector = _mm_set1_pd(sign);
+    for (size_t len = 4; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; j += 2) {
+                const __m128d w_re = _mm_loadu_pd(roots_re + half + j);
+                const __m128d w_im = _mm_mul_pd(sign_vector, _mm_loadu_pd(roots_im + half + j));
+                const __m128d x_re = _mm_loadu_pd(re + i + j + half), x_im = _mm_loadu_pd(im + i + j + half);
+                const __m128d v_re = _mm_sub_pd(_mm_mul_pd(x_re, w_re), _mm_mul_pd(x_im, w_im));
+                const __m128d v_im = _mm_add_pd(_mm_mul_pd(x_re, w_im), _mm_mul_pd(x_im, w_re));
+                const __m128d u_re = _mm_loadu_pd(re + i + j), u_im = _mm_loadu_pd(im + i + j);
+                _mm_storeu_pd(re + i + j + half, _mm_sub_pd(u_re, v_re));
+                _mm_storeu_pd(im + i + j + half, _mm_sub_pd(u_im, v_im));
+                _mm_storeu_pd(re + i + j, _mm_add_pd(u_re, v_re));
+                _mm_storeu_pd(im + i + j, _mm_add_pd(u_im, v_im));
+            }
+        }
     }
-    return result;
 }
 
-template<typename NumberType2>
-NumberType2 fft::reverse_bytes(NumberType2 input) {
-    NumberType2 result{0};
-    auto len = sizeof(NumberType2);
-    for (size_t i = 0; i < len / 2; ++i) {
-        std::swap(*(reinterpret_cast<uint8_t *>(&result) + i),
-                  *(reinterpret_cast<uint8_t *>(&result) + len - 1 - i));
+__attribute__((target("avx2")))
+void fft::butterflies_avx2(double *re, double *im, size_t n, const double *roots_re, const double *roots_im,
+                           double sign) {
+    stage_scalar(re, im, n, 2, roots_re, roots_im, sign);
+    stage_scalar(re, im, n, 4, roots_re, roots_im, sign);
+    const __m256d sign_vector = _mm256_set1_pd(sign);
+    for (size_t len = 8; len <= n; len <<= 1) {
+        const size_t half = len / 2;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t j = 0; j < half; j += 4) {
+                const __m256d w_re = _mm256_loadu_pd(roots_re + half + j);
+                const __m256d w_im = _mm256_mul_pd(sign_vector, _mm256_loadu_pd(roots_im + half + j));
+                const __m256d x_re = _mm256_loadu_pd(re + i + j + half), x_im = _mm256_loadu_pd(im + i + j + half);
+                const __m256d v_re = _mm256_sub_pd(_mm256_mul_pd(x_re, w_re), _mm256_mul_pd(x_im, w_im));
+                const __m256d v_im = _mm256_add_pd(_mm256_mul_pd(x_re, w_im), _mm256_mul_pd(x_im, w_re));
+                const __m256d u_re = _mm256_loadu_pd(re + i + j), u_im = _mm256_loadu_pd(im + i + j);
+                _mm256_storeu_pd(re + i + j + half, _mm256_sub_pd(u_re, v_re));
+                _mm256_storeu_pd(im + i + j + half, _mm256_sub_pd(u_im, v_im));
+                _mm256_storeu_pd(re + i + j, _mm256_add_pd(u_re, v_re));
+                _mm256_storeu_pd(im + i + j, _mm256_add_pd(u_im, v_im));
+            }
+        }
     }
-    return result;
 }
 
-template<>
-uint32_t fft::reverse_bytes<uint32_t>(uint32_t input) {
-    return ((input >> 24) & 0x000000FF) | ((input >> 8) & 0x0000FF00) | ((input << 8) & 0x00FF0000) |
-           ((input << 24) & 0xFF000000);
+#endif
+
+const fft::plan &fft::get_plan(size_t size) {
+    // планы храним по логарифму длины: длин, являющихся степенью двойки, немного
+    static std::vector<std::unique_ptr<plan>> plans(sizeof(size_t) * 8);
+    static std::mutex plans_mutex;  // без блокировки два потока могли бы одновременно строить план одной длины
+    size_t log_size = 0;
+    while ((static_cast<size_t>(1) << log_size) < size) {
+        ++log_size;
+    }
+    std::lock_guard<std::mutex> lock(plans_mutex);
+    if (!plans[log_size]) {
+        plans[log_size] = std::make_unique<plan>(size);
+    }
+    return *plans[log_size];
 }
 
-template<>
-uint64_t fft::reverse_bytes<uint64_t>(uint64_t input) {
-    uint64_t result = 0;
-    result |= reverse_bytes(static_cast<uint32_t>(input >> 32));
-    result |= static_cast<uint64_t>(reverse_bytes(static_cast<uint32_t>(input))) << 32;
-    return result;
+fft::real_plan::real_plan(size_t size) : half_(get_plan(size / 2)), twiddles_(size / 2) {
+    assert(size >= 2);
+    for (size_t k = 0; k < twiddles_.size(); ++k) {
+        double arg = 2 * M_PI * k / size;
+        twiddles_[k] = std::complex<double>(cos(arg), sin(arg));
+    }
 }
 
-template<>
-uint8_t fft::reverse_bits<uint8_t>(uint8_t input) {
-    static const uint8_t table[] = {
-            0x00, 0x80, 0x40, 0xc0, 0x20, 0xa0, 0x60, 0xe0,
-            0x10, 0x90, 0x50, 0xd0, 0x30, 0xb0, 0x70, 0xf0,
-            0x08, 0x88, 0x48, 0xc8, 0x28, 0xa8, 0x68, 0xe8,
-            0x18, 0x98, 0x58, 0xd8, 0x38, 0xb8, 0x78, 0xf8,
-            0x04, 0x84, 0x44, 0xc4, 0x24, 0xa4, 0x64, 0xe4,
-            0x14, 0x94, 0x54, 0xd4, 0x34, 0xb4, 0x74, 0xf4,
-            0x0c, 0x8c, 0x4c, 0xcc, 0x2c, 0xac, 0x6c, 0xec,
-            0x1c, 0x9c, 0x5c, 0xdc, 0x3c, 0xbc, 0x7c, 0xfc,
-            0x02, 0x82, 0x42, 0xc2, 0x22, 0xa2, 0x62, 0xe2,
-            0x12, 0x92, 0x52, 0xd2, 0x32, 0xb2, 0x72, 0xf2,
-            0x0a, 0x8a, 0x4a, 0xca, 0x2a, 0xaa, 0x6a, 0xea,
-            0x1a, 0x9a, 0x5a, 0xda, 0x3a, 0xba, 0x7a, 0xfa,
-            0x06, 0x86, 0x46, 0xc6, 0x26, 0xa6, 0x66, 0xe6,
-            0x16, 0x96, 0x56, 0xd6, 0x36, 0xb6, 0x76, 0xf6,
-            0x0e, 0x8e, 0x4e, 0xce, 0x2e, 0xae, 0x6e, 0xee,
-            0x1e, 0x9e, 0x5e, 0xde, 0x3e, 0xbe, 0x7e, 0xfe,
-            0x01, 0x81, 0x41, 0xc1, 0x21, 0xa1, 0x61, 0xe1,
-            0x11, 0x91, 0x51, 0xd1, 0x31, 0xb1, 0x71, 0xf1,
-            0x09, 0x89, 0x49, 0xc9, 0x29, 0xa9, 0x69, 0xe9,
-            0x19, 0x99, 0x59, 0xd9, 0x39, 0xb9, 0x79, 0xf9,
-            0x05, 0x85, 0x45, 0xc5, 0x25, 0xa5, 0x65, 0xe5,
-            0x15, 0x95, 0x55, 0xd5, 0x35, 0xb5, 0x75, 0xf5,
-            0x0d, 0x8d, 0x4d, 0xcd, 0x2d, 0xad, 0x6d, 0xed,
-            0x1d, 0x9d, 0x5d, 0xdd, 0x3d, 0xbd, 0x7d, 0xfd,
-            0x03, 0x83, 0x43, 0xc3, 0x23, 0xa3, 0x63, 0xe3,
-            0x13, 0x93, 0x53, 0xd3, 0x33, 0xb3, 0x73, 0xf3,
-            0x0b, 0x8b, 0x4b, 0xcb, 0x2b, 0xab, 0x6b, 0xeb,
-            0x1b, 0x9b, 0x5b, 0xdb, 0x3b, 0xbb, 0x7b, 0xfb,
-            0x07, 0x87, 0x47, 0xc7, 0x27, 0xa7, 0x67, 0xe7,
-            0x17, 0x97, 0x57, 0xd7, 0x37, 0xb7, 0x77, 0xf7,
-            0x0f, 0x8f, 0x4f, 0xcf, 0x2f, 0xaf, 0x6f, 0xef,
-            0x1f, 0x9f, 0x5f, 0xdf, 0x3f, 0xbf, 0x7f, 0xff,
-    };
-    return table[input];
+void fft::real_plan::split_spectrum(std::vector<std::complex<double>> &spectrum) const {
+    using namespace std::complex_literals;
+    /*
+     * z(m) = x(2m) + i x(2m+1), Z = FFT(z) длины n/2.
+     * Спектры чётных и нечётных отсчётов: E[k] = (Z[k] + Z[n/2-k]*)/2, O[k] = -i(Z[k] - Z[n/2-k]*)/2.
+     * Спектр сигнала: X[k] = E[k] + w^k O[k], w = exp(2*pi*i/n).
+     * E и O - спектры вещественных сигналов, поэтому E[n/2-k] = E[k]*, O[n/2-k] = O[k]*,
+     * и отсчёты k и n/2-k вычисляются вместе, на месте.
+     */
+    const auto half = half_.size();
+    half_.transform(spectrum);
+    spectrum.resize(half + 1);
+    const auto z0 = spectrum[0];
+    spectrum[0] = z0.real() + z0.imag();
+    spectrum[half] = z0.real() - z0.imag();
+    for (size_t k = 1; k <= half / 2; ++k) {
+        const auto z_k = spectrum[k], z_m = std::conj(spectrum[half - k]);
+        const auto even = (z_k + z_m) / 2.0, odd = -1.0i * (z_k - z_m) / 2.0;
+        spectrum[k] = even + twiddles_[k] * odd;
+        spectrum[half - k] = std::conj(even) + twiddles_[half - k] * std::conj(odd);
+    }
 }
 
-size_t solve_task(const std::string &text, std::string pattern, size_t k) {
-    if (text.size() < pattern.size()) {
-        return 0;
-    }
-    if (text.size() == pattern.size())
-    {
-        return static_cast<long>(text == pattern);
-    }
-    size_t pattern_length = pattern.size();
-
-    // С помощью fft мы умеем вычислять свёртку.
-    // Чтобы вычислить КФ с помощью операции свёртки, нужно развернуть один из операндов.
-    std::reverse(pattern.begin(), pattern.end());
-    pattern.resize(text.size());
-
-    // Будем отдельно подсчитывать совпадения для разных букв.
-    // Сначала найдём, в каких позициях встречается каждая из букв
-    std::queue<int64_t> indexes_a, indexes_c, indexes_g, indexes_t;
-    for (size_t i = 0; i < text.size(); ++i) {
-        if (text[i] == 'A') {
-            indexes_a.push(i);
-        }
-        if (text[i] == 'C') {
-            indexes_c.push(i);
-        }
-        if (text[i] == 'G') {
-            indexes_g.push(i);
-        }
-        if (text[i] == 'T') {
-            indexes_t.push(i);
-        }
-    }
-    // Теперь создадим массивы с отсчётами сигналов, соответствующих каждой из букв.
-    // В позициях, в которых встречаются буквы, а также на k позиций влево и вправо
-    // поставим значения 1.0, а в остальных местах 0.0.
-    std::vector<double>
-            text_a(text.size(), 0.0),
-            text_c(text.size(), 0.0),
-            text_g(text.size(), 0.0),
-            text_t(text.size(), 0.0);
-    std::vector<double>
-            pattern_a(pattern.size(), 0.0),
-            pattern_c(pattern.size(), 0.0),
-            pattern_g(pattern.size(), 0.0),
-            pattern_t(pattern.size(), 0.0);
-    for (int64_t i = 0; i < text.size(); ++i) {
-        while (!indexes_a.empty() && (i>indexes_a.front() + k))
-        {
-            indexes_a.pop();
+void fft::real_plan::inverse_transform(std::vector<std::complex<double>> &spectrum, std::vector<double> &samples) const {
+    using namespace std::complex_literals;
+    /*
+     * Обратные действия: E[k] = (X[k] + X[n/2-k]*)/2, O[k] = w^-k (X[k] - X[n/2-k]*)/2,
+     * Z[k] = E[k] + i O[k], затем обратное преобразование половинной длины даёт чётные и нечётные отсчёты.
+     */
+    const auto half = half_.size();
+    assert(spectrum.size() == half + 1);
+    const auto x0 = spectrum[0].real(), x_half = spectrum[half].real();
+    spectrum[0] = std::complex<double>((x0 + x_half) / 2.0, (x0 - x_half) / 2.0);
+    for (size_t k = 1; k <= half / 2; ++k) {
+        const auto x_k = spectrum[k], x_m = std::conj(spectrum[half - k]);
+        const auto even = (x_k + x_m) / 2.0, odd = std::conj(twiddles_[k]) * (x_k - x_m) / 2.0;
+        spectrum[k] = even + 1.0i * odd;
+        spectrum[half - k] = std::conj(even) + 1.0i * std::conj(odd);
+    }
+    spectrum.resize(half);
+    half_.transform(spectrum, true);
+    samples.resize(size());
+    for (size_t m = 0; m < half; ++m) {
+        samples[2 * m] = spectrum[m].real();
+        samples[2 * m + 1] = spectrum[m].imag();
+    }
+}
+
+const fft::real_plan &fft::get_real_plan(size_t length) {
+    static std::vector<std::unique_ptr<real_plan>> plans(sizeof(size_t) * 8);
+    static std::mutex plans_mutex;
+    size_t log_size = 1;
+    while ((static_cast<size_t>(1) << log_size) < length) {
+        ++log_size;
+    }
+    // план половинной длины берётся из get_plan под другой блокировкой, поэтому взаимной блокировки нет
+    std::lock_guard<std::mutex> lock(plans_mutex);
+    if (!plans[log_size]) {
+        plans[log_size] = std::make_unique<real_plan>(static_cast<size_t>(1) << log_size);
+    }
+    return *plans[log_size];
+}
+
+fft::correlator::correlator(const std::vector<std::vector<double>> &text)
+        : channels_(text.size()), text_length_(text.empty() ? 0 : text.front().size()),
+          real_plan_(get_real_plan(text_length_)), plan_(get_plan(real_plan_.size())) {
+    assert(std::all_of(text.begin(), text.end(),
+                       [this](const auto &channel) { return channel.size() == text_length_; }));
+    text_spectrums_ = pair_spectrums(text);
+}
+
+std::vector<std::vector<std::complex<double>>>
+fft::correlator::pair_spectrums(const std::vector<std::vector<double>> &channels) const {
+    std::vector<std::vector<std::complex<double>>> spectrums;
+    for (size_t c = 0; c < channels.size(); c += 2) {
+        std::vector<std::complex<double>> joined(plan_.size());
+        for (size_t i = 0; i < channels[c].size(); ++i) {
+            joined[i].real(channels[c][i]);
         }
-        while (!indexes_c.empty() && (i>indexes_c.front() + k))
-        {
-            indexes_c.pop();
+        if (c + 1 < channels.size()) {
+            for (size_t i = 0; i < channels[c + 1].size(); ++i) {
+                joined[i].imag(channels[c + 1][i]);
+            }
         }
-        while (!indexes_g.empty() && (i>indexes_g.front() + k))
-        {
-            indexes_g.pop();
+        plan_.transform(joined);
+        spectrums.push_back(std::move(joined));
+    }
+    return spectrums;
+}
+
+std::vector<double> fft::correlator::correlate(const std::vector<std::vector<double>> &pattern) const {
+    assert(pattern.size() == channels_);
+    const size_t pattern_length = pattern.empty() ? 0 : pattern.front().size();
+    assert(pattern_length <= text_length_);
+    assert(std::all_of(pattern.begin(), pattern.end(),
+                       [pattern_length](const auto &channel) { return channel.size() == pattern_length; }));
+    /*
+     * Для пары каналов текста z = x + iy и образца w = u + iv: FFT(z) * FFT(w)* - спектр корреляции z и w*,
+     * а её действительная часть sum(z[i + j] * w[j]*).re = sum(x[i + j] * u[j] + y[i + j] * v[j]) -
+     * как раз сумма корреляций обоих каналов. Спектры всех пар суммируем, обратное преобразование - одно на все каналы.
+     * Циклический сдвиг не портит результат: при i <= |text| - |pattern| индекс i + j не выходит за длину текста.
+     */
+    const auto pattern_spectrums = pair_spectrums(pattern);
+    const size_t n = plan_.size();
+    std::vector<std::complex<double>> sum(n);
+    for (size_t p = 0; p < pattern_spectrums.size(); ++p) {
+        for (size_t k = 0; k < n; ++k) {
+            sum[k] += text_spectrums_[p][k] * std::conj(pattern_spectrums[p][k]);
         }
-        while (!indexes_t.empty() && (i>indexes_t.front() + k))
-        {
-            indexes_t.pop();
+    }
+    /*
+     * Нужна только действительная часть корреляции. Её спектр - эрмитова часть суммы: (S[k] + S[n-k]*)/2,
+     * и он вычисляется вдвое более дешёвым обратным преобразованием вещественного сигнала.
+     */
+    std::vector<std::complex<double>> real_part(n / 2 + 1);
+    for (size_t k = 0; k <= n / 2; ++k) {
+        real_part[k] = (sum[k] + std::conj(sum[(n - k) % n])) / 2.0;
+    }
+    std::vector<double> samples;
+    real_plan_.inverse_transform(real_part, samples);
+    samples.resize(text_length_ - pattern_length + 1);
+    return samples;
+}
+
+fft::substring_stream::substring_stream(const std::string &pattern, size_t block_length)
+        : pattern_length_(pattern.size()), pattern_squares_(0),
+          plan_(get_real_plan(std::max(block_length == 0 ? std::max<size_t>(4 * pattern.size(), 1 << 16) : block_length,
+                                       pattern.size()))) {
+    assert(!pattern.empty());
+    /*
+     * Как и в calculate_matches, вхождение с позиции i - это B[i] = sum((p[j] - t[i+j])^2) = 0, где
+     * B[i] = sum(p[j]^2) - 2 * sum(p[j] * t[i+j]) + sum(t[i+j]^2). Средняя сумма - корреляционная функция,
+     * её спектр - произведение спектра текста на сопряжённый спектр образца. Его и сохраним.
+     */
+    std::vector<double> samples;
+    for (unsigned char symbol: pattern) {
+        samples.push_back(symbol);
+        pattern_squares_ += static_cast<int64_t>(symbol) * symbol;
+    }
+    plan_.transform(samples, pattern_spectrum_);
+    for (auto &value: pattern_spectrum_) {
+        value = std::conj(value);
+    }
+    block_.reserve(plan_.size());
+}
+
+const std::vector<size_t> &fft::substring_stream::process_block() {
+    found_.clear();
+    samples_.clear();
+    prefix_squares_.assign(1, 0);
+    for (unsigned char symbol: block_) {
+        samples_.push_back(symbol);
+        prefix_squares_.push_back(prefix_squares_.back() + static_cast<int64_t>(symbol) * symbol);
+    }
+    plan_.transform(samples_, spectrum_);
+    for (size_t k = 0; k < spectrum_.size(); ++k) {
+        spectrum_[k] *= pattern_spectrum_[k];
+    }
+    plan_.inverse_transform(spectrum_, samples_);
+
+    // Образец целиком лежит в блоке с позиций 0...|block|-|pattern|, для них циклический сдвиг ничего не портит
+    const size_t positions = block_.size() - pattern_length_ + 1;
+    for (size_t i = 0; i < positions; ++i) {
+        const auto text_squares = prefix_squares_[i + pattern_length_] - prefix_squares_[i];
+        if (pattern_squares_ + text_squares - 2 * std::llround(samples_[i]) == 0) {
+            found_.push_back(offset_ + i);
         }
-        if (!indexes_a.empty() &&
-                (i>=(indexes_a.front() - k)) &&
-                (i<=(indexes_a.front() + k)))
-        {
-            text_a[i] = 1.0;
+    }
+    // Следующий блок начнётся с последних |pattern|-1 символов текущего
+    block_.erase(0, positions);
+    offset_ += positions;
+    return found_;
+}
+
+std::vector<size_t> fft::mismatches(const std::string &text, const std::string &pattern, size_t k,
+                                    std::optional<char> wildcard) {
+    if (text.size() < pattern.size()) {
+        return {};
+    }
+    // Каналы нужны только для символов, которые встречаются в образце
+    std::string alphabet;
+    size_t significant = 0;  // сколько символов образца не джокеры
+    for (auto symbol: pattern) {
+        if (symbol == wildcard) {
+            continue;
         }
-        if (!indexes_c.empty() &&
-                (i>=(indexes_c.front() - k)) &&
-                (i<=(indexes_c.front() + k)))
-        {
-            text_c[i] = 1.0;
+        ++significant;
+        if (alphabet.find(symbol) == std::string::npos) {
+            alphabet += symbol;
         }
-        if (!indexes_g.empty() &&
-                (i>=(indexes_g.front() - k)) &&
-                (i<=(indexes_g.front() + k)))
-        {
-            text_g[i] = 1.0;
+    }
+    std::vector<size_t> result(text.size() - pattern.size() + 1, 0);
+    if (alphabet.empty()) {
+        return result;
+    }
+
+    std::vector<std::vector<double>> text_channels(alphabet.size(), std::vector<double>(text.size(), 0.0));
+    std::vector<std::vector<double>> pattern_channels(alphabet.size(), std::vector<double>(pattern.size(), 0.0));
+    std::vector<size_t> prefix_count(k == 0 ? 0 : text.size() + 1, 0);
+    for (size_t c = 0; c < alphabet.size(); ++c) {
+        // В позициях, в которых встречается буква или джокер, а также на k позиций влево и вправо,
+        // поставим значения 1.0, а в остальных местах 0.0.
+        if (k == 0) {
+            for (size_t i = 0; i < text.size(); ++i) {
+                text_channels[c][i] = text[i] == alphabet[c] || text[i] == wildcard ? 1.0 : 0.0;
+            }
+        } else {
+            // Сначала посчитаем, сколько раз они встречаются среди первых i символов текста.
+            for (size_t i = 0; i < text.size(); ++i) {
+                prefix_count[i + 1] = prefix_count[i] + (text[i] == alphabet[c] || text[i] == wildcard);
+            }
+            for (size_t i = 0; i < text.size(); ++i) {
+                const size_t left = i > k ? i - k : 0, right = std::min(text.size(), i + k + 1);
+                text_channels[c][i] = prefix_count[right] > prefix_count[left] ? 1.0 : 0.0;
+            }
         }
-        if (!indexes_t.empty() &&
-                (i>=(indexes_t.front() - k)) &&
-                (i<=(indexes_t.front() + k)))
-        {
-            text_t[i] = 1.0;
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            pattern_channels[c][i] = pattern[i] == alphabet[c] ? 1.0 : 0.0;
         }
     }
-    for (size_t i = 0; i < pattern.size(); ++i) {
-        if (pattern[i] == 'A') {
-            pattern_a[i] = 1.0;
+
+    // Сумма корреляций каналов - количество совпавших символов образца
+    auto corr_sum = correlator(text_channels).correlate(pattern_channels);
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = significant - std::llround(corr_sum[i]);
+    }
+    return result;
+}
+
+std::vector<size_t> fft::find_with_wildcards(const std::string &text, const std::string &pattern, char wildcard) {
+    if (text.size() < pattern.size() || pattern.empty()) {
+        return {};
+    }
+    /*
+     * Джокеру сопоставим 0, остальным символам - их номера 1, 2, ... в отсортированном алфавите:
+     * чем меньше числа, тем меньше значения свёрток.
+     * Вхождение с позиции i - это B[i] = sum(p[j] * t[i+j] * (p[j] - t[i+j])^2) = 0: слагаемое равно нулю,
+     * если символы совпали или один из них джокер, и положительно иначе.
+     * B[i] = sum(p[j]^3 * t[i+j]) - 2 * sum(p[j]^2 * t[i+j]^2) + sum(p[j] * t[i+j]^3) - три корреляции.
+     */
+    std::array<int64_t, 256> codes{};
+    for (unsigned char symbol: text + pattern) {
+        codes[symbol] = 1;
+    }
+    codes[static_cast<unsigned char>(wildcard)] = 0;
+    std::partial_sum(codes.begin(), codes.end(), codes.begin());
+    codes[static_cast<unsigned char>(wildcard)] = 0;
+    auto encode = [&codes](const std::string &line, int power, bool reversed) {
+        std::vector<int64_t> values;
+        values.reserve(line.size());
+        for (unsigned char symbol: line) {
+            int64_t value = 1;
+            for (int p = 0; p < power; ++p) {
+                value *= codes[symbol];
+            }
+            values.push_back(value);
         }
-        if (pattern[i] == 'C') {
-            pattern_c[i] = 1.0;
+        if (reversed) {
+            std::reverse(values.begin(), values.end());
         }
-        if (pattern[i] == 'G') {
-            pattern_g[i] = 1.0;
+        return values;
+    };
+    // Корреляцию находим как свёртку с развёрнутым образцом: c[m-1+i] = sum(p[j] * t[i+j])
+    std::vector<int64_t> b(text.size() - pattern.size() + 1, 0);
+    for (auto[text_power, pattern_power, factor]: {std::tuple{1, 3, 1}, std::tuple{2, 2, -2}, std::tuple{3, 1, 1}}) {
+        auto conv = convolution<int64_t, int64_t>(encode(text, text_power, false),
+                                                  encode(pattern, pattern_power, true));
+        for (size_t i = 0; i < b.size(); ++i) {
+            b[i] += factor * conv[pattern.size() - 1 + i];
         }
-        if (pattern[i] == 'T') {
-            pattern_t[i] = 1.0;
+    }
+    std::vector<size_t> result;
+    for (size_t i = 0; i < b.size(); ++i) {
+        if (b[i] == 0) {
+            result.push_back(i);
         }
     }
+    return result;
+}
 
-    // Вычислим все спектры
-    auto[spectrum_text_a, spectrum_text_c] = fft::double_transfrom(text_a, text_c);
-    auto[spectrum_text_g, spectrum_text_t] = fft::double_transfrom(text_g, text_t);
-    auto[spectrum_pattern_a, spectrum_pattern_c] = fft::double_transfrom(pattern_a, pattern_c);
-    auto[spectrum_pattern_g, spectrum_pattern_t] = fft::double_transfrom(pattern_g, pattern_t);
-
-    // Просуммируем спектры свёрток
-    std::vector<std::complex<double>> sum_spectrums;
-    sum_spectrums.reserve(spectrum_text_a.size());
-    for (size_t i = 0; i < spectrum_text_a.size(); ++i) {
-        sum_spectrums.push_back(
-                spectrum_text_a[i] * spectrum_pattern_a[i] +
-                        spectrum_text_c[i] * spectrum_pattern_c[i] +
-                        spectrum_text_g[i] * spectrum_pattern_g[i] +
-                        spectrum_text_t[i] * spectrum_pattern_t[i]);
-    }
+size_t fft::round_pow2(size_t number) {
+    double x = static_cast<double>(number -
+                                   1);  // если убрать "- 1", то "не меньше" в описании нужно заменить на "больше"
+    auto answer = reinterpret_cast<unsigned int *>(&x);
+    ++answer;
+    return static_cast<size_t>(1) << (((*answer & 0x7FF00000) >> 20) - 1022);
+}
 
-    // Найдём сумму свёрток, произведя обратное преобразование
-    auto corr_sum_samples = fft::transfrom(sum_spectrums, true);
+void fft::pad(std::vector<std::complex<double>> &samples) {
+    size_t new_size = round_pow2(samples.size());
+    samples.resize(new_size);
+}
 
-    auto count = std::count_if(corr_sum_samples.begin(), corr_sum_samples.end(),
-                         [pattern_length](const auto &elem) { return std::llround(elem.real()) == pattern_length; });
-    assert(count >= 0);
-    return count;
+size_t solve_task(const std::string &text, const std::string &pattern, size_t k) {
+    // Образец входит в текст, если для каждого его символа нашлась такая же буква в тексте
+    // на расстоянии не более k, то есть ни один символ не остался без пары.
+    auto distances = fft::mismatches(text, pattern, k);
+    return std::count(distances.begin(), distances.end(), 0);
 }
 
 // Начало тестов
@@ -613,7 +1349,162 @@ void test_from_task() {
 }
 
 
+void test_ntt_convolution() {
+    std::mt19937 gen(42);
+    // небольшие коэффициенты сворачиваются по одному модулю, большие - по трём;
+    // max_value^2 * 300 должно помещаться в int64_t, иначе эталонная свёртка переполнится
+    for (int64_t max_value: {1, 100, 1000000, 100000000}) {
+        std::uniform_int_distribution<int64_t> values_generator(-max_value, max_value);
+        std::uniform_int_distribution<size_t> length_generator(1, 300);
+        for (auto i = 0; i < 20; ++i) {
+            std::vector<int64_t> lhs(length_generator(gen)), rhs(length_generator(gen));
+            std::generate(lhs.begin(), lhs.end(), [&]() { return values_generator(gen); });
+            std::generate(rhs.begin(), rhs.end(), [&]() { return values_generator(gen); });
+            std::vector<int64_t> expected(lhs.size() + rhs.size() - 1);
+            for (size_t j = 0; j < lhs.size(); ++j) {
+                for (size_t k = 0; k < rhs.size(); ++k) {
+                    expected[j + k] += lhs[j] * rhs[k];
+                }
+            }
+            assert((fft::convolution<int64_t, int64_t>(lhs, rhs) == expected));
+        }
+    }
+}
+
+void test_real_convolution() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> values_generator(-1000, 1000);
+    std::uniform_int_distribution<size_t> length_generator(1, 300);
+    for (auto i = 0; i < 20; ++i) {
+        std::vector<int64_t> lhs(length_generator(gen)), rhs(length_generator(gen));
+        std::generate(lhs.begin(), lhs.end(), [&]() { return values_generator(gen); });
+        std::generate(rhs.begin(), rhs.end(), [&]() { return values_generator(gen); });
+        // вещественные сигналы сворачиваются через БПФ, целочисленные - через NTT
+        auto conv = fft::convolution<double, int64_t>({lhs.begin(), lhs.end()}, {rhs.begin(), rhs.end()});
+        assert((conv == fft::convolution<int64_t, int64_t>(lhs, rhs)));
+    }
+}
+
+void test_batch_correlation() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> values_generator(-10, 10);
+    std::uniform_int_distribution<size_t> length_generator(1, 300);
+    for (size_t channels = 1; channels <= 5; ++channels) {
+        const auto text_length = length_generator(gen);
+        std::vector<std::vector<double>> text(channels, std::vector<double>(text_length));
+        for (auto &channel: text) {
+            std::generate(channel.begin(), channel.end(), [&]() { return values_generator(gen); });
+        }
+        fft::correlator correlator(text);
+        // спектры текста вычислены один раз и переиспользуются для всех образцов
+        for (auto i = 0; i < 5; ++i) {
+            const auto pattern_length = length_generator(gen) % text_length + 1;
+            std::vector<std::vector<double>> pattern(channels, std::vector<double>(pattern_length));
+            for (auto &channel: pattern) {
+                std::generate(channel.begin(), channel.end(), [&]() { return values_generator(gen); });
+            }
+            auto corr = correlator.correlate(pattern);
+            assert(corr.size() == text_length - pattern_length + 1);
+            for (size_t shift = 0; shift < corr.size(); ++shift) {
+                double expected = 0;
+                for (size_t c = 0; c < channels; ++c) {
+                    for (size_t j = 0; j < pattern_length; ++j) {
+                        expected += text[c][shift + j] * pattern[c][j];
+                    }
+                }
+                assert(std::llround(corr[shift]) == std::llround(expected));
+            }
+        }
+    }
+}
+
+void test_substring_stream() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> length_generator(1, 20);
+    std::uniform_int_distribution<size_t> chunk_generator(1, 100);
+    for (auto i = 0; i < 50; ++i) {
+        std::string text, pattern;
+        const auto text_length = 10 * length_generator(gen) * length_generator(gen);
+        while (text.size() < text_length) {
+            text += "AC"[gen() % 2];
+        }
+        while (pattern.size() < length_generator(gen) % 5 + 1) {
+            pattern += "AC"[gen() % 2];
+        }
+        std::vector<size_t> expected;
+        for (auto position = text.find(pattern); position != std::string::npos;
+             position = text.find(pattern, position + 1)) {
+            expected.push_back(position);
+        }
+
+        // текст передаётся кусками произвольной длины, вхождения на стыках блоков и кусков не теряются
+        fft::substring_stream stream(pattern, 16);
+        std::vector<size_t> found;
+        auto on_match = [&found](size_t position) { found.push_back(position); };
+        for (size_t begin = 0; begin < text.size();) {
+            const auto length = std::min(chunk_generator(gen), text.size() - begin);
+            stream.feed(std::string_view(text).substr(begin, length), on_match);
+            begin += length;
+        }
+        stream.flush(on_match);
+        assert(found == expected);
+
+        found.clear();
+        std::istringstream input(text);
+        fft::find_substring(input, pattern, on_match, 32);
+        assert(found == expected);
+    }
+}
+
+void test_mismatches() {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> length_generator(1, 40);
+    for (auto i = 0; i < 200; ++i) {
+        const std::string alphabet = "ACG?";
+        std::string text, pattern;
+        const auto text_length = length_generator(gen), pattern_length = length_generator(gen) % text_length + 1;
+        while (text.size() < text_length) {
+            text += alphabet[gen() % alphabet.size()];
+        }
+        while (pattern.size() < pattern_length) {
+            pattern += alphabet[gen() % alphabet.size()];
+        }
+        const size_t k = gen() % 3;
+        const auto wildcard = gen() % 2 ? std::optional<char>('?') : std::nullopt;
+        auto distances = fft::mismatches(text, pattern, k, wildcard);
+        assert(distances.size() == text_length - pattern_length + 1);
+        std::vector<size_t> exact_matches;
+        for (size_t position = 0; position < distances.size(); ++position) {
+            size_t expected = 0;
+            for (size_t j = 0; j < pattern_length; ++j) {
+                if (pattern[j] == wildcard) {
+                    continue;
+                }
+                const auto center = position + j, left = center > k ? center - k : 0;
+                bool found = false;
+                for (auto p = left; p <= std::min(text_length - 1, center + k); ++p) {
+                    found = found || text[p] == pattern[j] || text[p] == wildcard;
+                }
+                expected += !found;
+            }
+            assert(distances[position] == expected);
+            if (k == 0 && wildcard && expected == 0) {
+                exact_matches.push_back(position);
+            }
+        }
+        // при k = 0 вхождения с джокерами - это положения с нулевым расстоянием
+        if (k == 0 && wildcard) {
+            assert(fft::find_with_wildcards(text, pattern, '?') == exact_matches);
+        }
+    }
+}
+
 void run_all_tests() {
+    test_ntt_convolution();
+    test_real_convolution();
+    test_batch_correlation();
+    test_substring_stream();
+    test_mismatches();
     test_from_task();
 }
 